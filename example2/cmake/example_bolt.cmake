@@ -0,0 +1,53 @@
+# Profiles example_app on a generated batch and optimizes its layout with BOLT,
+# writing <APP>.bolt.
+#
+#   cmake -DAPP=<example_app> -DLLVM_BOLT=<llvm-bolt> [-DPERF=<perf> -DPERF2BOLT=<perf2bolt>]
+#         -DWORK_DIR=<dir> -P example_bolt.cmake
+#
+# Without PERF, an instrumented copy of the binary records the profile.
+
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+function(run)
+	execute_process(COMMAND ${ARGV} RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "Command failed (${result}): ${ARGV}")
+	endif()
+endfunction()
+
+# The batch resembles production input: a few hundred thousand short names.
+set(chunk "")
+foreach(i RANGE 999)
+	string(APPEND chunk "Name ${i}\n")
+endforeach()
+string(REPEAT "${chunk}" 200 batch)
+file(WRITE ${WORK_DIR}/batch.txt "${batch}")
+
+set(profile ${WORK_DIR}/example_app.fdata)
+if(PERF)
+	execute_process(
+		COMMAND ${PERF} record -e cycles:u -j any,u -o ${WORK_DIR}/perf.data -- ${APP} --batch ${WORK_DIR}/batch.txt
+		OUTPUT_FILE ${WORK_DIR}/output.txt
+		WORKING_DIRECTORY ${WORK_DIR}
+		RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "perf record failed, LBR may not be available on this machine")
+	endif()
+	run(${PERF2BOLT} ${APP} -p ${WORK_DIR}/perf.data -o ${profile})
+else()
+	set(instrumented ${WORK_DIR}/example_app.instrumented)
+	run(${LLVM_BOLT} ${APP} -instrument -instrumentation-file=${profile} -o ${instrumented})
+	execute_process(
+		COMMAND ${instrumented} --batch ${WORK_DIR}/batch.txt
+		OUTPUT_FILE ${WORK_DIR}/output.txt
+		WORKING_DIRECTORY ${WORK_DIR}
+		RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "Instrumented example_app failed")
+	endif()
+endif()
+
+run(${LLVM_BOLT} ${APP} -o ${APP}.bolt -data=${profile}
+	-reorder-blocks=ext-tsp -reorder-functions=hfsort -split-functions -split-all-cold -dyno-stats)
+message(STATUS "Wrote ${APP}.bolt")
@@ -0,0 +1,87 @@
+# Summarizes the Clang -ftime-trace files of a build: the translation units
+# taking longest to compile, and the headers taking longest to parse, summed up
+# over all translation units including them.
+#
+#   cmake -DBUILD_DIR=<dir> [-DCOUNT=<n>] -P example_build_report.cmake
+
+if(NOT COUNT)
+	set(COUNT 20)
+endif()
+
+# Durations are zero padded, such that lists sort numerically.
+function(pad value outVar)
+	string(LENGTH "${value}" length)
+	math(EXPR zeros "15 - ${length}")
+	string(REPEAT "0" ${zeros} padding)
+	set(${outVar} "${padding}${value}" PARENT_SCOPE)
+endfunction()
+
+function(print_top title entries)
+	message("${title}")
+	list(SORT entries ORDER DESCENDING)
+	list(SUBLIST entries 0 ${COUNT} entries)
+	foreach(entry ${entries})
+		string(REPLACE "|" ";" fields "${entry}")
+		list(GET fields 1 duration)
+		list(GET fields 2 name)
+		math(EXPR milliseconds "${duration} / 1000")
+		string(LENGTH "${milliseconds}" length)
+		math(EXPR indent "8 - ${length}")
+		string(REPEAT " " ${indent} padding)
+		message("${padding}${milliseconds} ms  ${name}")
+	endforeach()
+	message("")
+endfunction()
+
+file(GLOB_RECURSE traces ${BUILD_DIR}/*.json)
+
+set(total 0)
+set(units "")
+set(header_keys "")
+foreach(trace ${traces})
+	if(NOT trace MATCHES "/CMakeFiles/")
+		continue()
+	endif()
+	file(READ ${trace} content)
+	if(NOT content MATCHES "\"dur\":([0-9]+),\"name\":\"Total ExecuteCompiler\"")
+		continue()
+	endif()
+
+	set(duration ${CMAKE_MATCH_1})
+	math(EXPR total "${total} + ${duration}")
+	pad(${duration} padded)
+	file(RELATIVE_PATH name ${BUILD_DIR} ${trace})
+	string(REGEX REPLACE "\\.json$" "" name "${name}")
+	list(APPEND units "${padded}|${duration}|${name}")
+
+	# Source events cover parsing a file, including the files it includes.
+	string(REGEX MATCHALL "\"dur\":[0-9]+,\"name\":\"Source\",\"args\":{\"detail\":\"[^\"]*\"}" sources "${content}")
+	foreach(source ${sources})
+		string(REGEX MATCH "\"dur\":([0-9]+),.*\"detail\":\"([^\"]*)\"" match "${source}")
+		string(MD5 key "${CMAKE_MATCH_2}")
+		if(NOT DEFINED header_${key})
+			set(header_${key} 0)
+			set(header_count_${key} 0)
+			set(header_name_${key} "${CMAKE_MATCH_2}")
+			list(APPEND header_keys ${key})
+		endif()
+		math(EXPR header_${key} "${header_${key}} + ${CMAKE_MATCH_1}")
+		math(EXPR header_count_${key} "${header_count_${key}} + 1")
+	endforeach()
+endforeach()
+
+if(NOT units)
+	message(FATAL_ERROR "No compile time traces found in ${BUILD_DIR}, build with Clang and EXAMPLE_TIME_TRACE first")
+endif()
+
+set(headers "")
+foreach(key ${header_keys})
+	pad(${header_${key}} padded)
+	list(APPEND headers "${padded}|${header_${key}}|${header_name_${key}} (${header_count_${key}}x)")
+endforeach()
+
+list(LENGTH units unit_count)
+math(EXPR total_seconds "${total} / 1000000")
+message("\nCompiling ${unit_count} translation units took ${total_seconds} s of CPU time\n")
+print_top("Heaviest translation units:" "${units}")
+print_top("Heaviest headers (parse time summed over all includes):" "${headers}")
@@ -0,0 +1,61 @@
+# Compiles a source file to assembly with optimizations and fails if the code
+# allocates or calls through a pointer, i.e. the compiler could not see through
+# an abstraction that is supposed to be free.
+#
+#   cmake -DCOMPILER=<c++> -DSOURCE=<file> -DINCLUDE_DIR=<dir> -DSYMBOLS=<names> [-DMAX_BRANCHES=<n>] [-DNO_CALLS=ON]
+#         -P example_codegen_check.cmake
+#
+# SYMBOLS is a comma-separated list of functions that must appear in the
+# output, such that a file compiling to nothing does not pass. If MAX_BRANCHES
+# is given, the file may contain at most that many conditional branches. With
+# NO_CALLS, the file must not call any function, including tail calls.
+
+execute_process(
+	COMMAND ${COMPILER} -std=c++20 -O2 -fno-asynchronous-unwind-tables -I${INCLUDE_DIR} -S -o - ${SOURCE}
+	OUTPUT_VARIABLE assembly
+	ERROR_VARIABLE errors
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Could not compile ${SOURCE}:\n${errors}")
+endif()
+
+string(REPLACE "," ";" symbols "${SYMBOLS}")
+foreach(symbol ${symbols})
+	if(NOT assembly MATCHES "${symbol}")
+		message(FATAL_ERROR "${symbol} is missing from the assembly of ${SOURCE}")
+	endif()
+endforeach()
+
+# Indirect calls and jumps on x86-64 and AArch64, and anything allocating.
+set(forbidden
+	"call[lq]?[ \t]+\\*"
+	"jmp[lq]?[ \t]+\\*"
+	"[ \t]bl?r[ \t]+x[0-9]"
+	"_Znwm|_Znam|malloc|_ZNSt8function")
+
+foreach(pattern ${forbidden})
+	string(REGEX MATCH "[^\n]*(${pattern})[^\n]*" line "${assembly}")
+	if(line)
+		message(FATAL_ERROR "Unexpected code in the assembly of ${SOURCE}:\n${line}")
+	endif()
+endforeach()
+
+# Conditional branches on x86-64 (any jcc, not jmp) and AArch64.
+if(DEFINED MAX_BRANCHES)
+	string(REGEX MATCHALL "\n[ \t]+(j[a-ln-z][a-z]*|b\\.[a-z]+|cbn?z|tbn?z)[ \t]" branches "${assembly}")
+	list(LENGTH branches branch_count)
+	if(branch_count GREATER MAX_BRANCHES)
+		message(FATAL_ERROR "${SOURCE} has ${branch_count} conditional branches, expected at most ${MAX_BRANCHES}:\n${branches}")
+	endif()
+endif()
+
+# Direct calls and tail calls on x86-64 and AArch64. Local labels start with a
+# dot, jumps to them are not calls.
+if(NO_CALLS)
+	string(REGEX MATCH "\n[ \t]+(call[lq]?|jmp[lq]?|bl?)[ \t]+[A-Za-z_][^\n]*" line "${assembly}")
+	if(line)
+		message(FATAL_ERROR "Unexpected call in the assembly of ${SOURCE}:${line}")
+	endif()
+endif()
+
+message(STATUS "${SOURCE}: no allocations or indirect calls")
@@ -0,0 +1,20 @@
+# Merges the raw profiles written by Clang-instrumented binaries into the
+# profile used by -fprofile-use.
+#
+#   cmake -DLLVM_PROFDATA=<llvm-profdata> -DPROFILE_DIR=<dir> -P example_pgo_merge.cmake
+
+if(NOT LLVM_PROFDATA)
+	message(FATAL_ERROR "llvm-profdata is required for profile-guided optimization with Clang")
+endif()
+
+file(GLOB raw_profiles ${PROFILE_DIR}/*.profraw)
+if(NOT raw_profiles)
+	message(FATAL_ERROR "No profiles found in ${PROFILE_DIR}")
+endif()
+
+execute_process(
+	COMMAND ${LLVM_PROFDATA} merge -output=${PROFILE_DIR}/default.profdata ${raw_profiles}
+	RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Merging profiles failed")
+endif()
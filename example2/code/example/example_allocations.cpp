@@ -0,0 +1,173 @@
+#include <example/example_allocations.hpp>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace Example {
+
+static thread_local AllocationStats t_allocations;
+
+AllocationStats threadAllocations()
+{
+	return t_allocations;
+}
+
+static void* allocate(std::size_t size, std::size_t alignment) noexcept
+{
+	t_allocations.allocations++;
+	t_allocations.bytes += size;
+
+	if (size == 0) {
+		size = 1;
+	}
+	if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+		return std::malloc(size);
+	}
+#if defined(_WIN32)
+	return _aligned_malloc(size, alignment);
+#else
+	// aligned_alloc requires the size to be a multiple of the alignment.
+	return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+static void* allocateOrThrow(std::size_t size, std::size_t alignment)
+{
+	while (true) {
+		if (void* pointer = allocate(size, alignment)) [[likely]] {
+			return pointer;
+		}
+		const std::new_handler handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+static void deallocate(void* pointer, std::size_t alignment) noexcept
+{
+	if (!pointer) {
+		return;
+	}
+	t_allocations.deallocations++;
+
+#if defined(_WIN32)
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+		_aligned_free(pointer);
+		return;
+	}
+#else
+	(void)alignment;
+#endif
+	std::free(pointer);
+}
+
+} // namespace Example
+
+using Example::allocate;
+using Example::allocateOrThrow;
+using Example::deallocate;
+
+constexpr std::size_t DefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void* operator new(std::size_t size)
+{
+	return allocateOrThrow(size, DefaultAlignment);
+}
+
+void* operator new[](std::size_t size)
+{
+	return allocateOrThrow(size, DefaultAlignment);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size, DefaultAlignment);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size, DefaultAlignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return allocateOrThrow(size, std::size_t(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return allocateOrThrow(size, std::size_t(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocate(size, std::size_t(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocate(size, std::size_t(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+	deallocate(pointer, DefaultAlignment);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	deallocate(pointer, DefaultAlignment);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	deallocate(pointer, DefaultAlignment);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	deallocate(pointer, DefaultAlignment);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	deallocate(pointer, DefaultAlignment);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	deallocate(pointer, DefaultAlignment);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+	deallocate(pointer, std::size_t(alignment));
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept
+{
+	deallocate(pointer, std::size_t(alignment));
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+	deallocate(pointer, std::size_t(alignment));
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+	deallocate(pointer, std::size_t(alignment));
+}
+
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	deallocate(pointer, std::size_t(alignment));
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	deallocate(pointer, std::size_t(alignment));
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Example {
+
+// Global operator new and delete are replaced to count allocations per thread.
+// The replacement is only linked into programs that link example_allocations,
+// like the tests and benchmarks; everything else keeps the default allocator.
+//
+// Counting is a thread-local increment, memory comes from malloc. Allocations
+// made directly through malloc are not counted.
+
+struct AllocationStats {
+	std::uint64_t allocations = 0;
+	std::uint64_t deallocations = 0;
+	std::uint64_t bytes = 0; // <- requested by allocations
+
+	AllocationStats operator-(const AllocationStats& other) const
+	{
+		return {allocations - other.allocations, deallocations - other.deallocations, bytes - other.bytes};
+	}
+};
+
+// Returns the totals of the calling thread since it started.
+AllocationStats threadAllocations();
+
+} // namespace Example
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_allocations.hpp>
+#include <example/example_error_context.hpp>
+#include <example/example_hello.hpp>
+#include <example/example_lines.hpp>
+#include <example/example_logger.hpp>
+
+using namespace Example;
+
+TEST_CASE("allocation counting", "[allocations]")
+{
+	struct alignas(128) Aligned {
+		char data[128];
+	};
+
+	const auto before = threadAllocations();
+	{
+		auto value = std::make_unique<int>(42);
+		auto aligned = std::make_unique<Aligned>();
+		REQUIRE(reinterpret_cast<std::uintptr_t>(aligned.get()) % alignof(Aligned) == 0);
+	}
+	const auto counted = threadAllocations() - before;
+
+	REQUIRE(counted.allocations == 2);
+	REQUIRE(counted.deallocations == 2);
+	REQUIRE(counted.bytes == sizeof(int) + sizeof(Aligned));
+}
+
+TEST_CASE("hello with name allocates at most 1 time", "[allocations]")
+{
+	g_logger.reset();
+
+	auto before = threadAllocations();
+	REQUIRE(hello("Tim") == "Hello Tim!");
+	REQUIRE((threadAllocations() - before).allocations == 0);
+
+	before = threadAllocations();
+	const auto greeting = hello("Bartholomew Montgomery");
+	REQUIRE((threadAllocations() - before).allocations == 1);
+	REQUIRE(greeting == "Hello Bartholomew Montgomery!");
+}
+
+TEST_CASE("hello appending does not allocate with enough capacity", "[allocations]")
+{
+	g_logger.reset();
+
+	std::string greeting;
+	greeting.reserve(64);
+
+	const auto before = threadAllocations();
+	hello(greeting, "Bartholomew Montgomery");
+	REQUIRE((threadAllocations() - before).allocations == 0);
+}
+
+TEST_CASE("line scanning does not allocate", "[allocations]")
+{
+	std::string input;
+	for (int i = 0; i < 1000; i++) {
+		input += "Name\r\n";
+	}
+
+	const auto before = threadAllocations();
+	LineScanner scanner(input);
+	std::string_view line;
+	std::size_t count = 0;
+	while (scanner.next(line)) {
+		count++;
+	}
+	REQUIRE((threadAllocations() - before).allocations == 0);
+	REQUIRE(count == 1000);
+}
+
+TEST_CASE("reporting malformed names does not allocate", "[allocations]")
+{
+	class CountingLogger : public ILogger {
+	  public:
+		void log(std::string_view) override { messages++; }
+		std::size_t messages = 0;
+	};
+	g_logger = std::make_unique<CountingLogger>();
+	auto* logger = static_cast<CountingLogger*>(g_logger.get());
+
+	const std::string longName(10000, 'x');
+	const std::string_view names[] = {"Tim\t", "\x01\x02", longName};
+
+	const auto before = threadAllocations();
+	EXAMPLE_ERROR_CONTEXT("reading batch file", "names.txt");
+	for (int i = 0; i < 1000; i++) {
+		for (const std::string_view name : names) {
+			if (const Status status = validateName(name); !status.ok()) {
+				reportError(status, name);
+			}
+		}
+	}
+	REQUIRE((threadAllocations() - before).allocations == 0);
+	REQUIRE(logger->messages == 3000);
+
+	g_logger.reset();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// EXAMPLE_API marks the functions, classes and variables the example library
+// exports when it is built as a shared library (BUILD_SHARED_LIBS). Everything
+// else is hidden: it stays out of the dynamic symbol table, and calls to it
+// from within the library are direct rather than going through the PLT.
+//
+// Inline functions and classes that are entirely inline need no marking. They
+// are compiled into every user, but the variables they access must be
+// exported, such that there is a single instance of each.
+#if defined(EXAMPLE_SHARED)
+#if defined(_WIN32)
+#if defined(EXAMPLE_BUILDING)
+#define EXAMPLE_API __declspec(dllexport)
+#else
+#define EXAMPLE_API __declspec(dllimport)
+#endif
+#else
+#define EXAMPLE_API __attribute__((visibility("default")))
+#endif
+#else
+#define EXAMPLE_API
+#endif
+
+// Concatenates two tokens after expanding them, for unique names in macros:
+//
+//   EXAMPLE_CONCAT(exampleDeferer, __COUNTER__)
+#define EXAMPLE_CONCAT_(x, y) x##y
+#define EXAMPLE_CONCAT(x, y) EXAMPLE_CONCAT_(x, y)
@@ -0,0 +1,19 @@
+// Compiled to assembly by the example_check_codegen test, which fails if the
+// function below has more than one conditional branch: a passing check is a
+// single compare, the failure path calls out of line, see example_check.hpp.
+//
+// This is compiled on its own, without the precompiled header.
+
+#include <atomic>
+#include <cstdint>
+
+#include <example/example_check.hpp>
+
+using namespace Example;
+
+int codegenCheck(int* out, int value)
+{
+	EXAMPLE_CHECK2(value > 0, -1);
+	*out = value;
+	return 0;
+}
@@ -0,0 +1,45 @@
+#include <example/example_check.hpp>
+
+#include <example/example_logger.hpp>
+
+namespace Example {
+
+static constinit std::atomic<CheckHandler> g_checkHandler = nullptr;
+static constinit std::atomic<CheckSite*> g_firstCheck = nullptr;
+
+CheckSite* firstCheck()
+{
+	return g_firstCheck.load(std::memory_order_acquire);
+}
+
+bool registerCheck(CheckSite& site)
+{
+	site.next = g_firstCheck.load(std::memory_order_relaxed);
+	while (!g_firstCheck.compare_exchange_weak(site.next, &site, std::memory_order_release,
+	                                           std::memory_order_relaxed)) {}
+	return true;
+}
+
+CheckHandler setCheckHandler(CheckHandler handler)
+{
+	return g_checkHandler.exchange(handler, std::memory_order_acq_rel);
+}
+
+void checkFailed(CheckSite& site)
+{
+	site.failures.fetch_add(1, std::memory_order_relaxed);
+
+	const std::string message = fmt::format("{}:{}: Check failed: {}", site.file, site.line, site.condition);
+	if (g_logger) {
+		g_logger->log(message);
+	}
+	else {
+		fmt::print(stderr, "{}\n", message);
+	}
+
+	if (const CheckHandler handler = g_checkHandler.load(std::memory_order_acquire)) {
+		handler(site);
+	}
+}
+
+} // namespace Example
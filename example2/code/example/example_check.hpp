@@ -0,0 +1,69 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+// Checks a condition that must hold, in every build. A failing check logs an
+// error, calls the check handler and returns from the calling function, with
+// the given value for EXAMPLE_CHECK2:
+//
+//   EXAMPLE_CHECK(effect);
+//   EXAMPLE_CHECK2(!path.empty(), StatusCode::InvalidArgument);
+//
+// A passing check costs a single branch, the failure path is out of line.
+#define EXAMPLE_CHECK(condition) EXAMPLE_CHECK_IMPL(condition, )
+#define EXAMPLE_CHECK2(condition, value) EXAMPLE_CHECK_IMPL(condition, value)
+#define EXAMPLE_CHECK_IMPL(condition, value) \
+	do { \
+		if (!(condition)) [[unlikely]] { \
+			static constinit ::Example::CheckSite exampleCheckSite = {#condition, __FILE__, __LINE__}; \
+			static_cast<void>(&::Example::CheckRegistration<&exampleCheckSite>::registered); \
+			::Example::checkFailed(exampleCheckSite); \
+			return value; \
+		} \
+	} while (false)
+
+namespace Example {
+
+// Every check has a CheckSite with static storage duration, which counts how
+// often it failed. Sites add themselves to a lock-free registry during static
+// initialization, like metrics do, from which all checks can be enumerated
+// whether they failed or not. Passing checks are not counted, that would add
+// an atomic increment to every check.
+struct CheckSite {
+	const char* condition;
+	const char* file;
+	int line;
+
+	std::atomic<std::uint64_t> failures = 0;
+	CheckSite* next = nullptr;
+};
+
+// The most recently registered site comes first.
+EXAMPLE_API CheckSite* firstCheck();
+
+// Adds the site to the registry, returns true.
+EXAMPLE_API bool registerCheck(CheckSite& site);
+
+// Instantiated for every check site by the failure path of EXAMPLE_CHECK,
+// registering the site before main rather than on its first failure.
+template <CheckSite* Site>
+struct CheckRegistration {
+	static inline const bool registered = registerCheck(*Site);
+};
+
+// The handler is called after the failure has been logged. It may break into
+// the debugger or terminate, by default there is none and the check returns.
+using CheckHandler = void (*)(const CheckSite& site);
+
+// Replaces the handler and returns the previous one, nullptr removes it.
+EXAMPLE_API CheckHandler setCheckHandler(CheckHandler handler);
+
+// Counts and logs the failure, then calls the handler.
+#if defined(__GNUC__)
+[[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+__declspec(noinline)
+#endif
+EXAMPLE_API void checkFailed(CheckSite& site);
+
+} // namespace Example
@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_check.hpp>
+#include <example/example_logger.test.hpp>
+#include <example/example_status.hpp>
+
+using namespace Example;
+
+static const CheckSite* g_handledCheck = nullptr;
+
+static void recordCheck(const CheckSite& site)
+{
+	g_handledCheck = &site;
+}
+
+static int g_doubled = 0;
+
+static void doublePositive(int value)
+{
+	EXAMPLE_CHECK(value > 0);
+	g_doubled = value * 2;
+}
+
+static Status checkName(std::string_view name)
+{
+	EXAMPLE_CHECK2(!name.empty(), StatusCode::InvalidArgument);
+	return {};
+}
+
+TEST_CASE("check passing", "[check]")
+{
+	doublePositive(21);
+	REQUIRE(g_doubled == 42);
+	REQUIRE(checkName("name").ok());
+}
+
+// Returns the registered site with the given condition.
+static const CheckSite* findCheck(std::string_view condition)
+{
+	const CheckSite* found = nullptr;
+	for (const CheckSite* site = firstCheck(); site; site = site->next) {
+		if (site->condition == condition) {
+			REQUIRE(!found); // <- each site is registered once
+			found = site;
+		}
+	}
+	return found;
+}
+
+TEST_CASE("check sites are registered before failing", "[check]")
+{
+	const CheckSite* site = findCheck("value > 0");
+	REQUIRE(site);
+	REQUIRE(std::string_view(site->file).ends_with("example_check.test.cpp"));
+	REQUIRE(findCheck("!name.empty()"));
+}
+
+TEST_CASE("check failing", "[check]")
+{
+	auto* logger = MockLogger::initialize();
+	const CheckHandler previous = setCheckHandler(recordCheck);
+
+	g_doubled = 0;
+	doublePositive(-1);
+	REQUIRE(g_doubled == 0);
+	REQUIRE(logger->lastMessage.ends_with("Check failed: value > 0"));
+
+	REQUIRE(g_handledCheck != nullptr);
+	const CheckSite* doubleCheck = g_handledCheck;
+	REQUIRE(std::string_view(doubleCheck->condition) == "value > 0");
+	REQUIRE(doubleCheck->failures == 1);
+
+	REQUIRE(checkName("").code() == StatusCode::InvalidArgument);
+	const CheckSite* nameCheck = g_handledCheck;
+	REQUIRE(nameCheck != doubleCheck);
+
+	doublePositive(0);
+	REQUIRE(doubleCheck->failures == 2);
+	REQUIRE(nameCheck->failures == 1);
+
+	REQUIRE(findCheck("value > 0") == doubleCheck);
+	REQUIRE(findCheck("!name.empty()") == nameCheck);
+
+	REQUIRE(setCheckHandler(previous) == recordCheck);
+	g_logger.reset();
+}
@@ -0,0 +1,25 @@
+#include <example/example_checksum.hpp>
+
+#include <example/example_isa.hpp>
+
+namespace Example {
+
+using Crc32cKernel = std::uint32_t (*)(const char* data, std::size_t size, std::uint32_t crc);
+
+// Starts out with a resolver, which replaces itself by the kernel for the CPU.
+static std::uint32_t resolveCrc32c(const char* data, std::size_t size, std::uint32_t crc);
+static std::atomic<Crc32cKernel> g_crc32c = resolveCrc32c;
+
+static std::uint32_t resolveCrc32c(const char* data, std::size_t size, std::uint32_t crc)
+{
+	const Crc32cKernel kernel = EXAMPLE_ISA_SELECT(crc32c);
+	g_crc32c.store(kernel, std::memory_order_relaxed);
+	return kernel(data, size, crc);
+}
+
+std::uint32_t crc32c(std::string_view data, std::uint32_t crc)
+{
+	return g_crc32c.load(std::memory_order_relaxed)(data.data(), data.size(), crc);
+}
+
+} // namespace Example
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// Computes the CRC-32C (Castagnoli) checksum of the given data. Pass the
+// previous result as crc to checksum data incrementally. The kernel is selected
+// for the CPU, see example_isa.hpp.
+EXAMPLE_API std::uint32_t crc32c(std::string_view data, std::uint32_t crc = 0);
+
+} // namespace Example
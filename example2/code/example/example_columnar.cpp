@@ -0,0 +1,207 @@
+#include <example/example_columnar.hpp>
+
+#include <example/example_check.hpp>
+#include <example/example_checksum.hpp>
+
+namespace Example {
+
+// Header fields and offsets are written and read in native byte order.
+static_assert(std::endian::native == std::endian::little);
+
+static std::uint32_t headerChecksum(ColumnarHeader header)
+{
+	header.headerChecksum = 0;
+	return crc32c({reinterpret_cast<const char*>(&header), sizeof(header)});
+}
+
+static std::string_view asBytes(const std::uint64_t* values, std::size_t count)
+{
+	return {reinterpret_cast<const char*>(values), count * sizeof(std::uint64_t)};
+}
+
+std::unique_ptr<ColumnarWriter> ColumnarWriter::create(std::string_view filename)
+{
+	std::unique_ptr<ColumnarWriter> writer(new ColumnarWriter);
+	writer->m_offsetsFilename = std::string(filename) + ".offsets";
+	writer->m_offsets.reset(new std::uint64_t[OffsetBlockSize]);
+	writer->m_offsets[writer->m_offsetCount++] = 0;
+
+	writer->m_file = std::fopen(std::string(filename).c_str(), "wb");
+	if (!writer->m_file) {
+		return nullptr;
+	}
+
+	// The heap is written in many small pieces, let the stream collect them.
+	constexpr std::size_t bufferSize = 1 << 20;
+	writer->m_fileBuffer.reset(new char[bufferSize]);
+	std::setvbuf(writer->m_file, writer->m_fileBuffer.get(), _IOFBF, bufferSize);
+
+	// Placeholder, the actual header is written by finish.
+	const ColumnarHeader header;
+	if (std::fwrite(&header, sizeof(header), 1, writer->m_file) != 1) {
+		return nullptr;
+	}
+	return writer;
+}
+
+ColumnarWriter::~ColumnarWriter() noexcept
+{
+	if (m_file) {
+		std::fclose(m_file);
+	}
+	closeOffsetsFile();
+}
+
+void ColumnarWriter::add(std::string_view value)
+{
+	EXAMPLE_CHECK(m_file); // <- finish has not been called yet
+	if (std::fwrite(value.data(), 1, value.size(), m_file) != value.size()) {
+		m_failed = true;
+	}
+	m_heapChecksum = crc32c(value, m_heapChecksum);
+
+	if (m_offsetCount == OffsetBlockSize) [[unlikely]] {
+		m_failed |= !spillOffsets();
+	}
+	m_heapSize += value.size();
+	m_offsets[m_offsetCount++] = m_heapSize;
+}
+
+// Moves the collected offsets to the temporary file, which is created on first
+// use. The block is emptied even on failure, the writer has failed anyway.
+bool ColumnarWriter::spillOffsets()
+{
+	const std::size_t count = m_offsetCount;
+	m_offsetCount = 0;
+	m_offsetsChecksum = crc32c(asBytes(m_offsets.get(), count), m_offsetsChecksum);
+	m_spilledOffsets += count;
+
+	if (!m_offsetsFile) {
+		m_offsetsFile = std::fopen(m_offsetsFilename.c_str(), "w+b");
+		if (!m_offsetsFile) {
+			return false;
+		}
+		// Where open files can be removed, the file disappears right away and
+		// cannot be left behind.
+		m_offsetsFileRemoved = std::remove(m_offsetsFilename.c_str()) == 0;
+	}
+	return std::fwrite(m_offsets.get(), sizeof(std::uint64_t), count, m_offsetsFile) == count;
+}
+
+void ColumnarWriter::closeOffsetsFile()
+{
+	if (m_offsetsFile) {
+		std::fclose(m_offsetsFile);
+		m_offsetsFile = nullptr;
+		if (!m_offsetsFileRemoved) {
+			std::remove(m_offsetsFilename.c_str());
+		}
+	}
+}
+
+bool ColumnarWriter::finish()
+{
+	EXAMPLE_CHECK2(m_file, false);
+
+	// Offsets that were spilled before are completed in the temporary file and
+	// copied from there, using the block as buffer.
+	const std::uint64_t offsetCount = m_spilledOffsets + m_offsetCount;
+	if (m_offsetsFile) {
+		m_failed |= !spillOffsets();
+	}
+	else {
+		m_offsetsChecksum = crc32c(asBytes(m_offsets.get(), m_offsetCount));
+	}
+
+	ColumnarHeader header;
+	header.count = offsetCount - 1;
+	header.heapOffset = sizeof(header);
+	header.heapSize = m_heapSize;
+	header.offsetsOffset = (header.heapOffset + header.heapSize + 7) & ~std::uint64_t(7);
+	header.heapChecksum = m_heapChecksum;
+	header.offsetsChecksum = m_offsetsChecksum;
+	header.headerChecksum = headerChecksum(header);
+
+	const char padding[8] = {};
+	const std::size_t paddingSize = header.offsetsOffset - header.heapOffset - header.heapSize;
+	m_failed |= std::fwrite(padding, 1, paddingSize, m_file) != paddingSize;
+	if (m_offsetsFile) {
+		std::uint64_t copied = 0;
+		m_failed |= std::fseek(m_offsetsFile, 0, SEEK_SET) != 0;
+		while (!m_failed) {
+			const std::size_t count =
+			    std::fread(m_offsets.get(), sizeof(std::uint64_t), OffsetBlockSize, m_offsetsFile);
+			if (count == 0) {
+				break;
+			}
+			m_failed |= std::fwrite(m_offsets.get(), sizeof(std::uint64_t), count, m_file) != count;
+			copied += count;
+		}
+		m_failed |= copied != offsetCount;
+		closeOffsetsFile();
+	}
+	else {
+		m_failed |= std::fwrite(m_offsets.get(), sizeof(std::uint64_t), m_offsetCount, m_file) != m_offsetCount;
+	}
+	m_failed |= std::fseek(m_file, 0, SEEK_SET) != 0;
+	m_failed |= std::fwrite(&header, sizeof(header), 1, m_file) != 1;
+	m_failed |= std::fclose(m_file) != 0;
+	m_file = nullptr;
+
+	return !m_failed;
+}
+
+std::unique_ptr<ColumnarReader> ColumnarReader::open(std::string_view filename, bool verify)
+{
+	auto file = MappedFile::open(filename);
+	if (!file) {
+		return nullptr;
+	}
+
+	const std::string_view data = file->data();
+	ColumnarHeader header;
+	if (data.size() < sizeof(header)) {
+		return nullptr;
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+
+	if (header.magic != ColumnarHeader::Magic || header.version != ColumnarHeader::CurrentVersion
+	    || header.headerChecksum != headerChecksum(header)) {
+		return nullptr;
+	}
+
+	// Check the sections against the file size, written such that none of the
+	// computations can overflow.
+	const std::uint64_t fileSize = data.size();
+	const std::uint64_t offsetsSize = (header.count + 1) * sizeof(std::uint64_t);
+	if (header.heapOffset > fileSize || header.heapSize > fileSize - header.heapOffset
+	    || header.offsetsOffset > fileSize || header.count >= fileSize / sizeof(std::uint64_t)
+	    || offsetsSize > fileSize - header.offsetsOffset) {
+		return nullptr;
+	}
+
+	std::unique_ptr<ColumnarReader> reader(new ColumnarReader);
+	reader->m_heap = data.substr(header.heapOffset, header.heapSize);
+	reader->m_offsets = data.data() + header.offsetsOffset;
+	reader->m_count = std::size_t(header.count);
+	reader->m_file = std::move(file);
+
+	if (verify) {
+		if (crc32c(reader->m_heap) != header.heapChecksum
+		    || crc32c({reader->m_offsets, offsetsSize}) != header.offsetsChecksum) {
+			return nullptr;
+		}
+		if (reader->offset(0) != 0 || reader->offset(reader->m_count) != header.heapSize) {
+			return nullptr;
+		}
+		for (std::size_t i = 0; i < reader->m_count; i++) {
+			if (reader->offset(i) > reader->offset(i + 1)) {
+				return nullptr;
+			}
+		}
+	}
+
+	return reader;
+}
+
+} // namespace Example
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <example/example_api.hpp>
+#include <example/example_mapped_file.hpp>
+
+namespace Example {
+
+// The columnar format stores a sequence of strings such that they can be
+// accessed without parsing. The layout is:
+//
+//   ColumnarHeader
+//   heap     all strings concatenated, no separators
+//   padding  up to the next multiple of 8
+//   offsets  count + 1 little-endian u64, string i is heap[offsets[i], offsets[i + 1])
+//
+// The header is stored as is, all fields are little-endian. Heap, offsets and
+// header (with headerChecksum set to 0) are each covered by a CRC-32C.
+struct ColumnarHeader {
+	static constexpr std::uint32_t Magic = 0x52434745; // "EGCR"
+	static constexpr std::uint32_t CurrentVersion = 1;
+
+	std::uint32_t magic = Magic;
+	std::uint32_t version = CurrentVersion;
+	std::uint64_t count = 0;
+	std::uint64_t heapOffset = 0;
+	std::uint64_t heapSize = 0;
+	std::uint64_t offsetsOffset = 0;
+	std::uint32_t heapChecksum = 0;
+	std::uint32_t offsetsChecksum = 0;
+	std::uint32_t headerChecksum = 0;
+	std::uint32_t reserved = 0;
+};
+static_assert(sizeof(ColumnarHeader) == 56);
+
+// ColumnarWriter streams strings into the heap section of a columnar file. The
+// offsets are collected in a block of fixed size, full blocks are moved to a
+// temporary file next to the output (<filename>.offsets), such that memory use
+// does not depend on the number of strings. finish appends the offsets and
+// fills in the header.
+class EXAMPLE_API ColumnarWriter {
+  public:
+	static constexpr std::size_t OffsetBlockSize = 1 << 16;
+
+	static std::unique_ptr<ColumnarWriter> create(std::string_view filename);
+
+	~ColumnarWriter() noexcept;
+
+	ColumnarWriter(const ColumnarWriter&) = delete;
+	ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+	void add(std::string_view value);
+
+	// Completes the file. Nothing may be added afterwards.
+	bool finish();
+
+  private:
+	ColumnarWriter() = default;
+
+	bool spillOffsets();
+	void closeOffsetsFile();
+
+	std::FILE* m_file = nullptr;
+	std::unique_ptr<char[]> m_fileBuffer;
+
+	std::string m_offsetsFilename;
+	std::FILE* m_offsetsFile = nullptr;
+	bool m_offsetsFileRemoved = false;
+	std::unique_ptr<std::uint64_t[]> m_offsets;
+	std::size_t m_offsetCount = 0;      // <- in m_offsets
+	std::uint64_t m_spilledOffsets = 0; // <- in m_offsetsFile
+
+	std::uint64_t m_heapSize = 0;
+	std::uint32_t m_heapChecksum = 0;
+	std::uint32_t m_offsetsChecksum = 0;
+	bool m_failed = false;
+};
+
+// ColumnarReader maps a columnar file and provides zero-copy access to its
+// strings. All returned views point into the mapping and stay valid for the
+// lifetime of the reader.
+class EXAMPLE_API ColumnarReader {
+  public:
+	// Structural checks are always done. Verification additionally computes
+	// all checksums and validates every offset, which touches the whole file.
+	static std::unique_ptr<ColumnarReader> open(std::string_view filename, bool verify = true);
+
+	std::size_t size() const { return m_count; }
+
+	// Returns an empty view for indices that are out of range or refer to
+	// broken offsets in an unverified file.
+	std::string_view operator[](std::size_t index) const { return slice(index, index + 1); }
+
+	// Returns strings [first, last) as one contiguous view into the heap.
+	std::string_view slice(std::size_t first, std::size_t last) const
+	{
+		if (first > last || last > m_count) {
+			return {};
+		}
+		const std::uint64_t begin = offset(first);
+		const std::uint64_t end = offset(last);
+		if (begin > end || end > m_heap.size()) {
+			return {};
+		}
+		return m_heap.substr(begin, end - begin);
+	}
+
+	std::uint64_t offset(std::size_t index) const
+	{
+		std::uint64_t value;
+		std::memcpy(&value, m_offsets + index * sizeof(value), sizeof(value));
+		return value;
+	}
+
+  private:
+	ColumnarReader() = default;
+
+	std::unique_ptr<MappedFile> m_file;
+	std::string_view m_heap;
+	const char* m_offsets = nullptr;
+	std::size_t m_count = 0;
+};
+
+} // namespace Example
@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_allocations.hpp>
+#include <example/example_checksum.hpp>
+#include <example/example_columnar.hpp>
+
+using namespace Example;
+
+TEST_CASE("crc32c", "[columnar]")
+{
+	REQUIRE(crc32c("") == 0);
+	REQUIRE(crc32c("123456789") == 0xE3069283);
+	REQUIRE(crc32c("56789", crc32c("1234")) == 0xE3069283);
+}
+
+TEST_CASE("columnar round trip", "[columnar]")
+{
+	const auto filename = "example_columnar.test.bin";
+	{
+		auto writer = ColumnarWriter::create(filename);
+		REQUIRE(writer);
+		writer->add("Hello Tim!");
+		writer->add("");
+		writer->add("Hello!");
+		REQUIRE(writer->finish());
+	}
+
+	auto reader = ColumnarReader::open(filename);
+	REQUIRE(reader);
+	REQUIRE(reader->size() == 3);
+	REQUIRE((*reader)[0] == "Hello Tim!");
+	REQUIRE((*reader)[1] == "");
+	REQUIRE((*reader)[2] == "Hello!");
+	REQUIRE((*reader)[3] == "");
+	REQUIRE(reader->slice(0, 3) == "Hello Tim!Hello!");
+
+	reader.reset();
+	std::remove(filename);
+}
+
+TEST_CASE("columnar offsets are not kept in memory", "[columnar]")
+{
+	const auto filename = "example_columnar_large.test.bin";
+	const std::size_t count = 3 * ColumnarWriter::OffsetBlockSize + 5;
+	{
+		auto writer = ColumnarWriter::create(filename);
+		REQUIRE(writer);
+
+		// Full blocks of offsets go to a temporary file, adding never
+		// allocates however many strings there are.
+		const auto before = threadAllocations();
+		for (std::size_t i = 0; i < count; i++) {
+			writer->add(i % 2 ? "Hello Tim!" : "Hello!");
+		}
+		REQUIRE((threadAllocations() - before).allocations == 0);
+		REQUIRE(writer->finish());
+	}
+	REQUIRE(!std::fopen((std::string(filename) + ".offsets").c_str(), "rb"));
+
+	auto reader = ColumnarReader::open(filename);
+	REQUIRE(reader);
+	REQUIRE(reader->size() == count);
+	REQUIRE((*reader)[0] == "Hello!");
+	REQUIRE((*reader)[ColumnarWriter::OffsetBlockSize] == "Hello!");
+	REQUIRE((*reader)[count - 1] == "Hello!");
+	REQUIRE((*reader)[count - 2] == "Hello Tim!");
+
+	reader.reset();
+	std::remove(filename);
+}
+
+TEST_CASE("columnar corruption", "[columnar]")
+{
+	const auto filename = "example_columnar_corrupt.test.bin";
+	{
+		auto writer = ColumnarWriter::create(filename);
+		REQUIRE(writer);
+		writer->add("Hello Tim!");
+		REQUIRE(writer->finish());
+	}
+
+	// Flip a byte in the heap, right after the header.
+	{
+		std::FILE* file = std::fopen(filename, "r+b");
+		REQUIRE(file);
+		std::fseek(file, sizeof(ColumnarHeader), SEEK_SET);
+		std::fputc('J', file);
+		std::fclose(file);
+	}
+
+	REQUIRE(!ColumnarReader::open(filename));
+	REQUIRE(ColumnarReader::open(filename, false));
+
+	std::remove(filename);
+}
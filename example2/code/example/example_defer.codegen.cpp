@@ -0,0 +1,44 @@
+// Compiled to assembly by the example_defer_codegen test, which fails if any
+// of the functions below allocate or call through a pointer. Deferred code
+// must be inlined as if written out at every exit, see example_defer.hpp.
+//
+// This is compiled on its own, without the precompiled header.
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <example/example_defer.hpp>
+
+using namespace Example;
+
+Status acquireResource(int& outHandle) noexcept;
+Status useResource(int handle) noexcept;
+void releaseResource(int handle) noexcept;
+
+int codegenDefer(int handle)
+{
+	EXAMPLE_DEFER(releaseResource(handle));
+	if (handle < 0) {
+		return 0;
+	}
+	return handle * 2;
+}
+
+Status codegenDeferFail(int& outHandle)
+{
+	Status status = acquireResource(outHandle);
+	if (!status.ok()) {
+		return status;
+	}
+	EXAMPLE_DEFER_FAIL(status, releaseResource(outHandle));
+	status = useResource(outHandle);
+	return status;
+}
+
+Status codegenDeferSuccess(int handle)
+{
+	Status status = useResource(handle);
+	EXAMPLE_DEFER_SUCCESS(status, releaseResource(handle));
+	return status;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <example/example_api.hpp>
+#include <example/example_status.hpp>
+
+// Runs the given code when leaving the current scope, in reverse order of
+// declaration like destructors, however the scope is left:
+//
+//   const int fd = ::open(filename, O_RDONLY);
+//   EXAMPLE_DEFER(close(fd));
+//
+// The code is a lambda capturing by reference and is inlined at every exit;
+// there is no allocation and no call through a pointer. It must not throw.
+#define EXAMPLE_DEFER(...) \
+	const ::Example::Deferer EXAMPLE_CONCAT(exampleDeferer, __COUNTER__)([&]() noexcept { __VA_ARGS__; })
+
+// Like EXAMPLE_DEFER, only runs the code if status, a Status variable, holds
+// an error when leaving the scope. Rolls back partial work:
+//
+//   Status status = writeHeader(file);
+//   EXAMPLE_DEFER_FAIL(status, std::remove(filename));
+#define EXAMPLE_DEFER_FAIL(status, ...) EXAMPLE_DEFER(if (!(status).ok()) { __VA_ARGS__; })
+
+// Like EXAMPLE_DEFER, only runs the code if status is ok when leaving the scope.
+#define EXAMPLE_DEFER_SUCCESS(status, ...) EXAMPLE_DEFER(if ((status).ok()) { __VA_ARGS__; })
+
+namespace Example {
+
+// Deferer calls its function on destruction. It is neither copyable nor
+// movable, the function runs exactly once.
+template <typename Function>
+class Deferer {
+  public:
+	static_assert(std::is_nothrow_invocable_v<Function&>, "deferred code runs in a destructor");
+
+	explicit Deferer(Function&& function) noexcept : m_function(std::move(function)) {}
+	~Deferer() noexcept { m_function(); }
+
+	Deferer(const Deferer&) = delete;
+	Deferer& operator=(const Deferer&) = delete;
+
+  private:
+	Function m_function;
+};
+
+} // namespace Example
@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_defer.hpp>
+
+using namespace Example;
+
+static void deferTwice(std::string& outOrder, bool returnEarly)
+{
+	EXAMPLE_DEFER(outOrder += 'a');
+	EXAMPLE_DEFER(outOrder += 'b');
+	if (returnEarly) {
+		return;
+	}
+	outOrder += '-';
+}
+
+static Status deferStatus(std::string& outOrder, Status result)
+{
+	Status status;
+	EXAMPLE_DEFER_FAIL(status, outOrder += "fail");
+	EXAMPLE_DEFER_SUCCESS(status, outOrder += "success");
+	status = result;
+	return status;
+}
+
+TEST_CASE("defer", "[defer]")
+{
+	std::string order;
+	deferTwice(order, false);
+	REQUIRE(order == "-ba");
+
+	order.clear();
+	deferTwice(order, true);
+	REQUIRE(order == "ba");
+}
+
+TEST_CASE("defer by status", "[defer]")
+{
+	std::string order;
+	REQUIRE(deferStatus(order, {}).ok());
+	REQUIRE(order == "success");
+
+	order.clear();
+	REQUIRE(deferStatus(order, StatusCode::IoError).code() == StatusCode::IoError);
+	REQUIRE(order == "fail");
+}
+
+static_assert(std::is_nothrow_destructible_v<Deferer<void (*)() noexcept>>);
+static_assert(!std::is_copy_constructible_v<Deferer<void (*)() noexcept>>);
+static_assert(!std::is_move_constructible_v<Deferer<void (*)() noexcept>>);
@@ -0,0 +1,100 @@
+#include <example/example_error_context.hpp>
+
+#include <example/example_logger.hpp>
+
+namespace Example {
+
+static constinit thread_local const ErrorContext* t_errorContext = nullptr;
+static constinit thread_local std::array<char, ErrorMessageCapacity> t_errorMessage = {};
+
+ErrorContext::ErrorContext(StatusMessage message, std::string_view detail)
+    : m_message(message), m_detail(detail), m_outer(t_errorContext)
+{
+	t_errorContext = this;
+}
+
+ErrorContext::~ErrorContext() noexcept
+{
+	t_errorContext = m_outer;
+}
+
+const ErrorContext* ErrorContext::current()
+{
+	return t_errorContext;
+}
+
+namespace {
+
+// Appends to the buffer until it is full, the rest is cut off.
+class ErrorMessageWriter {
+  public:
+	ErrorMessageWriter(std::array<char, ErrorMessageCapacity>& buffer)
+	    : m_begin(buffer.data()), m_out(buffer.data()), m_end(buffer.data() + buffer.size())
+	{}
+
+	template <typename... Args>
+	void write(fmt::format_string<Args...> format, Args&&... args)
+	{
+		m_out = fmt::format_to_n(m_out, std::size_t(m_end - m_out), format, std::forward<Args>(args)...).out;
+	}
+
+	// Details often come from the input, control characters in them are
+	// escaped such that they don't garble the log.
+	void writeDetail(std::string_view detail)
+	{
+		if (detail.empty()) {
+			return;
+		}
+		write(": '");
+		while (!detail.empty()) {
+			const auto control = std::find_if(detail.begin(), detail.end(), [](char c) {
+				return static_cast<unsigned char>(c) < 0x20 || c == 0x7F;
+			});
+			const auto plain = std::size_t(control - detail.begin());
+			write("{}", detail.substr(0, plain));
+			if (control == detail.end()) {
+				break;
+			}
+			write("\\x{:02x}", static_cast<unsigned char>(*control));
+			detail.remove_prefix(plain + 1);
+		}
+		write("'");
+	}
+
+	std::string_view view() const { return {m_begin, std::size_t(m_out - m_begin)}; }
+
+  private:
+	char* m_begin;
+	char* m_out;
+	char* m_end;
+};
+
+} // namespace
+
+std::string_view formatError(Status status, std::string_view detail)
+{
+	ErrorMessageWriter writer(t_errorMessage);
+	writer.write("{}", statusCodeName(status.code()));
+	if (const char* message = status.message(); *message) {
+		writer.write(": {}", message);
+	}
+	writer.writeDetail(detail);
+	for (const ErrorContext* context = t_errorContext; context; context = context->outer()) {
+		writer.write(", while {}", context->message());
+		writer.writeDetail(context->detail());
+	}
+	return writer.view();
+}
+
+void reportError(Status status, std::string_view detail)
+{
+	const std::string_view message = formatError(status, detail);
+	if (g_logger) {
+		g_logger->log(message);
+	}
+	else {
+		fmt::print(stderr, "{}\n", message);
+	}
+}
+
+} // namespace Example
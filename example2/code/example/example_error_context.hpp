@@ -0,0 +1,58 @@
+#pragma once
+
+#include <example/example_api.hpp>
+#include <example/example_status.hpp>
+
+// Describes what the current scope is doing, for errors reported from within
+// it. The message must be a string literal and is interned once per call site;
+// the detail is viewed, not copied, and must outlive the scope:
+//
+//   EXAMPLE_ERROR_CONTEXT("reading batch file", filename);
+#define EXAMPLE_ERROR_CONTEXT(message, detail) \
+	const ::Example::ErrorContext EXAMPLE_CONCAT(exampleErrorContext, __COUNTER__)( \
+		EXAMPLE_STATUS_MESSAGE(message), detail)
+
+namespace Example {
+
+// Errors are logged where they happen, together with what the thread was doing
+// at the time. The context is a chain of ErrorContext frames living on the
+// stack, each linking to the enclosing one; entering and leaving a context
+// only updates a thread-local pointer. Reporting formats into a fixed buffer
+// per thread, so neither side allocates, no matter how many errors occur.
+class EXAMPLE_API ErrorContext {
+  public:
+	explicit ErrorContext(StatusMessage message, std::string_view detail = {});
+	~ErrorContext() noexcept;
+
+	ErrorContext(const ErrorContext&) = delete;
+	ErrorContext& operator=(const ErrorContext&) = delete;
+
+	// Returns the innermost context of the calling thread, or nullptr.
+	static const ErrorContext* current();
+
+	const char* message() const { return m_message.text(); }
+	std::string_view detail() const { return m_detail; }
+	const ErrorContext* outer() const { return m_outer; }
+
+  private:
+	StatusMessage m_message;
+	std::string_view m_detail;
+	const ErrorContext* m_outer;
+};
+
+// Size of the per-thread buffer, longer messages are truncated.
+inline constexpr std::size_t ErrorMessageCapacity = 1024;
+
+// Formats the status, the detail and the context of the calling thread, the
+// innermost first:
+//
+//   invalid argument: Malformed name: 'Tim\x09', while reading batch file: 'names.txt'
+//
+// Control characters in details are escaped. The result views the thread's
+// buffer and is valid until the next call.
+EXAMPLE_API std::string_view formatError(Status status, std::string_view detail = {});
+
+// Logs formatError to g_logger, or to stderr if there is no logger.
+EXAMPLE_API void reportError(Status status, std::string_view detail = {});
+
+} // namespace Example
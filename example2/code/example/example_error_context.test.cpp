@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_error_context.hpp>
+#include <example/example_logger.test.hpp>
+
+using namespace Example;
+
+static std::string_view formatNested()
+{
+	EXAMPLE_ERROR_CONTEXT("reading batch file", "names.txt");
+	REQUIRE(std::string_view(ErrorContext::current()->message()) == "reading batch file");
+	{
+		EXAMPLE_ERROR_CONTEXT("processing batch", "");
+		return formatError(EXAMPLE_STATUS(StatusCode::InvalidArgument, "Malformed name"), "Tim\t");
+	}
+}
+
+TEST_CASE("error context formatting", "[error_context]")
+{
+	REQUIRE(ErrorContext::current() == nullptr);
+	REQUIRE(formatError(StatusCode::NotFound) == "not found");
+	REQUIRE(formatError(StatusCode::NotFound, "names.txt") == "not found: 'names.txt'");
+
+	REQUIRE(formatNested()
+	        == "invalid argument: Malformed name: 'Tim\\x09', while processing batch, while reading batch file: 'names.txt'");
+	REQUIRE(ErrorContext::current() == nullptr);
+}
+
+TEST_CASE("error context truncation", "[error_context]")
+{
+	const std::string detail(2 * ErrorMessageCapacity, 'x');
+	const std::string_view message = formatError(StatusCode::InvalidArgument, detail);
+	REQUIRE(message.size() == ErrorMessageCapacity);
+	REQUIRE(message.starts_with("invalid argument: 'xxx"));
+}
+
+TEST_CASE("error context per thread", "[error_context]")
+{
+	EXAMPLE_ERROR_CONTEXT("running test", "");
+
+	const ErrorContext* other = nullptr;
+	std::thread([&] { other = ErrorContext::current(); }).join();
+	REQUIRE(other == nullptr);
+	REQUIRE(ErrorContext::current() != nullptr);
+}
+
+TEST_CASE("error reporting", "[error_context]")
+{
+	auto* logger = MockLogger::initialize();
+
+	EXAMPLE_ERROR_CONTEXT("running test", "");
+	reportError(EXAMPLE_STATUS(StatusCode::IoError, "Could not read"), "names.txt");
+	REQUIRE(logger->lastMessage == "I/O error: Could not read: 'names.txt', while running test");
+
+	g_logger.reset();
+}
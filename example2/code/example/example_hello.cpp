@@ -1,19 +1,69 @@
 #include <example/example_hello.hpp>
 
 #include <example/example_logger.hpp>
+#include <example/example_metrics.hpp>
+#include <example/example_trace.hpp>
 
 namespace Example {
 
-std::string hello(std::string_view name)
+static Counter g_helloCalls("example_hello_calls_total", "Number of greetings created.");
+static Histogram g_helloDuration("example_hello_duration_seconds", "Time spent creating a greeting.", 1e9);
+
+static void appendGreeting(std::string& outGreeting, std::string_view name)
 {
-	if (g_logger) {
-		g_logger->log("Example::hello called");
+	if (name.empty()) {
+		outGreeting += "Hello!";
+		return;
 	}
+	outGreeting += "Hello ";
+	outGreeting += name;
+	outGreeting += '!';
+}
 
-	if (name.empty()) {
-		return "Hello!";
+std::string hello(std::string_view name)
+{
+	return traceCall("Example::hello", [&] {
+		g_helloCalls.add();
+		ScopedTimer timer(g_helloDuration);
+
+		if (g_logger) {
+			g_logger->log("Example::hello called");
+		}
+
+		// Sized up front, such that the greeting is allocated at most once.
+		std::string greeting;
+		greeting.reserve(name.size() + 7);
+		appendGreeting(greeting, name);
+		return greeting;
+	});
+}
+
+void hello(std::string& outGreeting, std::string_view name)
+{
+	traceCall("Example::hello", [&] {
+		g_helloCalls.add();
+		ScopedTimer timer(g_helloDuration);
+
+		if (g_logger) {
+			g_logger->log("Example::hello called");
+		}
+
+		appendGreeting(outGreeting, name);
+	});
+}
+
+Status validateName(std::string_view name)
+{
+	if (name.size() > MaxNameLength) {
+		return EXAMPLE_STATUS(StatusCode::InvalidArgument, "Name too long");
+	}
+	for (const char c : name) {
+		const auto byte = static_cast<unsigned char>(c);
+		if (byte < 0x20 || byte == 0x7F) {
+			return EXAMPLE_STATUS(StatusCode::InvalidArgument, "Name contains control characters");
+		}
 	}
-	return "Hello " + std::string(name) + "!";
+	return {};
 }
 
 } // namespace Example
@@ -1,7 +1,20 @@
 #pragma once
 
+#include <example/example_api.hpp>
+#include <example/example_status.hpp>
+
 namespace Example {
 
-std::string hello(std::string_view name);
+EXAMPLE_API std::string hello(std::string_view name);
+
+// Appends the greeting to outGreeting instead of returning a new string. This
+// allows the caller to reuse the same buffer for many greetings.
+EXAMPLE_API void hello(std::string& outGreeting, std::string_view name);
+
+inline constexpr std::size_t MaxNameLength = 256;
+
+// Names longer than MaxNameLength or containing control characters, such as
+// stray tabs or binary data, are rejected with StatusCode::InvalidArgument.
+EXAMPLE_API Status validateName(std::string_view name);
 
 } // namespace Example
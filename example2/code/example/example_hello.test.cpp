@@ -16,6 +16,29 @@ TEST_CASE("hello without name", "[hello]")
 	REQUIRE(hello("") == "Hello!");
 }
 
+TEST_CASE("hello appending", "[hello]")
+{
+	std::string greeting = "> ";
+	hello(greeting, "Tim");
+	REQUIRE(greeting == "> Hello Tim!");
+
+	greeting.clear();
+	hello(greeting, "");
+	REQUIRE(greeting == "Hello!");
+}
+
+TEST_CASE("hello name validation", "[hello]")
+{
+	REQUIRE(validateName("Tim").ok());
+	REQUIRE(validateName("").ok());
+	REQUIRE(validateName("Zoë").ok());
+	REQUIRE(validateName(std::string(MaxNameLength, 'x')).ok());
+
+	REQUIRE(validateName(std::string(MaxNameLength + 1, 'x')).code() == StatusCode::InvalidArgument);
+	REQUIRE(validateName("Tim\t").code() == StatusCode::InvalidArgument);
+	REQUIRE(validateName(std::string_view("T\0m", 3)).code() == StatusCode::InvalidArgument);
+}
+
 TEST_CASE("hello logging", "[hello]")
 {
 	auto* logger = MockLogger::initialize();
@@ -0,0 +1,59 @@
+#include <example/example_isa.hpp>
+
+#define EXAMPLE_ISA_NAMESPACE baseline
+#include <example/example_isa_kernels.inc>
+
+namespace Example {
+
+IsaLevel supportedIsaLevel()
+{
+#if defined(EXAMPLE_MULTI_ISA)
+	// The features the kernels rely on, plus those the compiler makes most use
+	// of at each level. Checks for AVX and AVX-512 include operating system
+	// support for the wider registers.
+	__builtin_cpu_init();
+	if (!__builtin_cpu_supports("sse4.2") || !__builtin_cpu_supports("popcnt")) {
+		return IsaLevel::Baseline;
+	}
+	if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("bmi2") || !__builtin_cpu_supports("fma")) {
+		return IsaLevel::X86_64_V2;
+	}
+	if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512bw")
+	    || !__builtin_cpu_supports("avx512vl") || !__builtin_cpu_supports("avx512dq")) {
+		return IsaLevel::X86_64_V3;
+	}
+	return IsaLevel::X86_64_V4;
+#else
+	return IsaLevel::Baseline;
+#endif
+}
+
+IsaLevel isaLevel()
+{
+	static const IsaLevel level = [] {
+		const IsaLevel supported = supportedIsaLevel();
+		const char* requested = std::getenv("EXAMPLE_ISA");
+		if (!requested) {
+			return supported;
+		}
+		for (auto level = IsaLevel::Baseline; level < supported; level = IsaLevel(int(level) + 1)) {
+			if (std::strcmp(requested, isaLevelName(level)) == 0) {
+				return level;
+			}
+		}
+		return supported;
+	}();
+	return level;
+}
+
+const char* isaLevelName(IsaLevel level)
+{
+	switch (level) {
+	case IsaLevel::X86_64_V2: return "x86-64-v2";
+	case IsaLevel::X86_64_V3: return "x86-64-v3";
+	case IsaLevel::X86_64_V4: return "x86-64-v4";
+	default: return "baseline";
+	}
+}
+
+} // namespace Example
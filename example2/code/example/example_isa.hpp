@@ -0,0 +1,68 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// Hot kernels are compiled several times, once per x86-64 microarchitecture
+// level, into namespaces of the same name (see example_isa_kernels.inc and
+// EXAMPLE_MULTI_ISA). The kernel for the best level the CPU supports is picked
+// on first use. Builds for other architectures or without EXAMPLE_MULTI_ISA
+// only contain the baseline kernels.
+enum class IsaLevel { Baseline, X86_64_V2, X86_64_V3, X86_64_V4 };
+
+// Returns the best level supported by both the CPU and the build.
+EXAMPLE_API IsaLevel supportedIsaLevel();
+
+// Returns the level kernels are selected for. This is the supported level,
+// unless the EXAMPLE_ISA environment variable (baseline, x86-64-v2, x86-64-v3
+// or x86-64-v4) asks for a lower one, e.g. for comparing the kernels.
+EXAMPLE_API IsaLevel isaLevel();
+
+EXAMPLE_API const char* isaLevelName(IsaLevel level);
+
+// Picks the kernel for isaLevel() from the kernels for each level.
+template <typename Kernel>
+Kernel selectIsaKernel(Kernel baseline, Kernel v2, Kernel v3, Kernel v4)
+{
+	switch (isaLevel()) {
+	case IsaLevel::X86_64_V4: return v4;
+	case IsaLevel::X86_64_V3: return v3;
+	case IsaLevel::X86_64_V2: return v2;
+	default: return baseline;
+	}
+}
+
+#if defined(EXAMPLE_MULTI_ISA)
+#define EXAMPLE_ISA_SELECT(kernel) \
+	::Example::selectIsaKernel(&::Example::baseline::kernel, &::Example::x86_64_v2::kernel, \
+	                           &::Example::x86_64_v3::kernel, &::Example::x86_64_v4::kernel)
+#else
+#define EXAMPLE_ISA_SELECT(kernel) (&::Example::baseline::kernel)
+#endif
+
+// The kernels behind newlineMask and crc32c, see there. Raw pointers are used
+// instead of std::string_view, see example_isa_kernels.inc.
+namespace baseline {
+EXAMPLE_API std::uint64_t newlineMask(const char* block);
+EXAMPLE_API std::uint32_t crc32c(const char* data, std::size_t size, std::uint32_t crc);
+} // namespace baseline
+
+#if defined(EXAMPLE_MULTI_ISA)
+namespace x86_64_v2 {
+EXAMPLE_API std::uint64_t newlineMask(const char* block);
+EXAMPLE_API std::uint32_t crc32c(const char* data, std::size_t size, std::uint32_t crc);
+} // namespace x86_64_v2
+
+namespace x86_64_v3 {
+EXAMPLE_API std::uint64_t newlineMask(const char* block);
+EXAMPLE_API std::uint32_t crc32c(const char* data, std::size_t size, std::uint32_t crc);
+} // namespace x86_64_v3
+
+namespace x86_64_v4 {
+EXAMPLE_API std::uint64_t newlineMask(const char* block);
+EXAMPLE_API std::uint32_t crc32c(const char* data, std::size_t size, std::uint32_t crc);
+} // namespace x86_64_v4
+#endif
+
+} // namespace Example
@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include <example/example_checksum.hpp>
+#include <example/example_isa.hpp>
+#include <example/example_lines.hpp>
+
+using namespace Example;
+
+struct IsaKernels {
+	IsaLevel level;
+	std::uint64_t (*newlineMask)(const char* block);
+	std::uint32_t (*crc32c)(const char* data, std::size_t size, std::uint32_t crc);
+};
+
+// The kernels of every level this CPU can run.
+static std::vector<IsaKernels> supportedKernels()
+{
+	std::vector<IsaKernels> kernels = {{IsaLevel::Baseline, baseline::newlineMask, baseline::crc32c}};
+#if defined(EXAMPLE_MULTI_ISA)
+	const IsaKernels levels[] = {
+		{IsaLevel::X86_64_V2, x86_64_v2::newlineMask, x86_64_v2::crc32c},
+		{IsaLevel::X86_64_V3, x86_64_v3::newlineMask, x86_64_v3::crc32c},
+		{IsaLevel::X86_64_V4, x86_64_v4::newlineMask, x86_64_v4::crc32c},
+	};
+	for (const IsaKernels& level : levels) {
+		if (level.level <= supportedIsaLevel()) {
+			kernels.push_back(level);
+		}
+	}
+#endif
+	return kernels;
+}
+
+TEST_CASE("isa level", "[isa]")
+{
+	REQUIRE(isaLevel() <= supportedIsaLevel());
+	REQUIRE(std::string_view(isaLevelName(IsaLevel::Baseline)) == "baseline");
+	REQUIRE(std::string_view(isaLevelName(IsaLevel::X86_64_V3)) == "x86-64-v3");
+}
+
+TEST_CASE("isa kernels agree", "[isa]")
+{
+	std::mt19937_64 random(42);
+	std::string data(4096 + 7, '\0');
+	for (char& c : data) {
+		c = random() % 4 == 0 ? '\n' : char(random());
+	}
+
+	for (const IsaKernels& kernels : supportedKernels()) {
+		INFO(isaLevelName(kernels.level));
+
+		REQUIRE(kernels.crc32c("123456789", 9, 0) == 0xE3069283);
+		REQUIRE(kernels.crc32c("56789", 5, kernels.crc32c("1234", 4, 0)) == 0xE3069283);
+		const std::size_t sizes[] = {0, 1, 7, 8, 9, 63, data.size()};
+		for (std::size_t size : sizes) {
+			REQUIRE(kernels.crc32c(data.data(), size, 0) == crc32c(std::string_view(data).substr(0, size)));
+		}
+
+		for (std::size_t offset = 0; offset + 64 <= data.size(); offset += 61) {
+			std::uint64_t expected = 0;
+			for (std::size_t i = 0; i < 64; i++) {
+				expected |= std::uint64_t(data[offset + i] == '\n') << i;
+			}
+			REQUIRE(kernels.newlineMask(data.data() + offset) == expected);
+		}
+	}
+}
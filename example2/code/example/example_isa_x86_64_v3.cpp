@@ -0,0 +1,14 @@
+// Compiled with -march=x86-64-v3 when EXAMPLE_MULTI_ISA is enabled, without
+// the precompiled header. See example_isa_kernels.inc for what may be used.
+#if defined(EXAMPLE_MULTI_ISA)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <example/example_isa.hpp>
+
+#define EXAMPLE_ISA_NAMESPACE x86_64_v3
+#include <example/example_isa_kernels.inc>
+
+#endif
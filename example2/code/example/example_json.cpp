@@ -0,0 +1,23 @@
+#include <example/example_json.hpp>
+
+namespace Example {
+
+void appendJsonString(std::string& out, std::string_view value)
+{
+	out += '"';
+	for (char c : value) {
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20) {
+			fmt::format_to(std::back_inserter(out), "\\u{:04x}", unsigned(c));
+		}
+		else {
+			out += c;
+		}
+	}
+	out += '"';
+}
+
+} // namespace Example
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// Appends value as quoted and escaped JSON string.
+EXAMPLE_API void appendJsonString(std::string& out, std::string_view value);
+
+} // namespace Example
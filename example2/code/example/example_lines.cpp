@@ -0,0 +1,25 @@
+#include <example/example_lines.hpp>
+
+#include <example/example_isa.hpp>
+
+namespace Example {
+
+using NewlineMaskKernel = std::uint64_t (*)(const char* block);
+
+// Starts out with a resolver, which replaces itself by the kernel for the CPU.
+static std::uint64_t resolveNewlineMask(const char* block);
+static std::atomic<NewlineMaskKernel> g_newlineMask = resolveNewlineMask;
+
+static std::uint64_t resolveNewlineMask(const char* block)
+{
+	const NewlineMaskKernel kernel = EXAMPLE_ISA_SELECT(newlineMask);
+	g_newlineMask.store(kernel, std::memory_order_relaxed);
+	return kernel(block);
+}
+
+std::uint64_t newlineMask(const char* block)
+{
+	return g_newlineMask.load(std::memory_order_relaxed)(block);
+}
+
+} // namespace Example
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// newlineMask returns a bit mask where bit i is set iff block[i] is '\n'. The
+// block must be 64 bytes long. The kernel is selected for the CPU, see
+// example_isa.hpp.
+EXAMPLE_API std::uint64_t newlineMask(const char* block);
+
+// LineScanner splits a buffer into lines without copying. The returned views
+// point into the scanned buffer. Newlines are located 64 bytes at a time, the
+// positions are then consumed from the resulting bit mask.
+//
+// Both "\n" and "\r\n" line endings are accepted. A trailing newline at the end
+// of the buffer does not yield an additional empty line.
+class LineScanner {
+  public:
+	explicit LineScanner(std::string_view data) : m_data(data) {}
+
+	bool next(std::string_view& outLine)
+	{
+		while (m_mask == 0) {
+			if (m_blockEnd >= m_data.size()) {
+				return nextTail(outLine);
+			}
+			scanBlock();
+		}
+
+		const std::size_t position = m_blockEnd - 64 + std::size_t(std::countr_zero(m_mask));
+		m_mask &= m_mask - 1;
+
+		outLine = trimCarriageReturn(m_data.substr(m_lineBegin, position - m_lineBegin));
+		m_lineBegin = position + 1;
+		return true;
+	}
+
+  private:
+	void scanBlock()
+	{
+		if (m_data.size() - m_blockEnd >= 64) {
+			m_mask = newlineMask(m_data.data() + m_blockEnd);
+		}
+		else {
+			// Never read past the end of the buffer; it may be the end of a
+			// mapping.
+			char block[64] = {};
+			std::memcpy(block, m_data.data() + m_blockEnd, m_data.size() - m_blockEnd);
+			m_mask = newlineMask(block);
+		}
+		m_blockEnd += 64;
+	}
+
+	bool nextTail(std::string_view& outLine)
+	{
+		if (m_lineBegin >= m_data.size()) {
+			return false;
+		}
+		outLine = trimCarriageReturn(m_data.substr(m_lineBegin));
+		m_lineBegin = m_data.size();
+		return true;
+	}
+
+	static std::string_view trimCarriageReturn(std::string_view line)
+	{
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		return line;
+	}
+
+	std::string_view m_data;
+	std::size_t m_lineBegin = 0;
+	std::size_t m_blockEnd = 0;
+	std::uint64_t m_mask = 0;
+};
+
+} // namespace Example
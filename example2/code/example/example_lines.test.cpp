@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include <example/example_lines.hpp>
+
+using namespace Example;
+
+static std::vector<std::string_view> splitLines(std::string_view data)
+{
+	std::vector<std::string_view> lines;
+	LineScanner scanner(data);
+	for (std::string_view line; scanner.next(line);) {
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+TEST_CASE("newline mask", "[lines]")
+{
+	char block[64] = {};
+	block[0] = '\n';
+	block[17] = '\n';
+	block[63] = '\n';
+	REQUIRE(newlineMask(block) == ((1ull << 0) | (1ull << 17) | (1ull << 63)));
+}
+
+TEST_CASE("line scanner", "[lines]")
+{
+	REQUIRE(splitLines("").empty());
+	REQUIRE(splitLines("Tim") == std::vector<std::string_view>{"Tim"});
+	REQUIRE(splitLines("Tim\n") == std::vector<std::string_view>{"Tim"});
+	REQUIRE(splitLines("Tim\r\nTom\n") == std::vector<std::string_view>{"Tim", "Tom"});
+	REQUIRE(splitLines("\n\nTim") == std::vector<std::string_view>{"", "", "Tim"});
+}
+
+TEST_CASE("line scanner across blocks", "[lines]")
+{
+	std::string data;
+	std::vector<std::string> expected;
+	for (int i = 0; i < 100; i++) {
+		expected.push_back(std::string(std::size_t(i % 70), char('a' + i % 26)));
+		data += expected.back() + "\n";
+	}
+	data.pop_back();
+
+	const auto lines = splitLines(data);
+	REQUIRE(lines.size() == expected.size());
+	for (std::size_t i = 0; i < lines.size(); i++) {
+		REQUIRE(lines[i] == expected[i]);
+	}
+}
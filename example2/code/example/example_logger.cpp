@@ -0,0 +1,7 @@
+#include <example/example_logger.hpp>
+
+namespace Example {
+
+constinit std::unique_ptr<ILogger> g_logger;
+
+} // namespace Example
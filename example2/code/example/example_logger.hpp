@@ -1,19 +1,26 @@
 #pragma once
 
+#include <example/example_api.hpp>
+
 namespace Example {
 
 // ILogger defines a very basic logger interface for illustration purposes.
 // There are two real implementations: ConsoleLogger and FileLogger; there's
 // also a MockLogger that can be used for testing.
-class ILogger {
+class EXAMPLE_API ILogger {
   public:
 	virtual void log(std::string_view) = 0;
+
+	// Writes out any buffered messages. Loggers without buffering don't need
+	// to override this.
+	virtual void flush() {}
+
 	virtual ~ILogger() noexcept = default;
 };
 
 // g_logger is the default logger instance that can be accessed across the
 // code-base. The instance is located on the heap and owned by this unique
 // pointer.
-inline std::unique_ptr<ILogger> g_logger;
+EXAMPLE_API extern std::unique_ptr<ILogger> g_logger;
 
 } // namespace Example
@@ -0,0 +1,12 @@
+#include <example/example_api.hpp>
+#include <example/example_metrics.hpp>
+
+namespace Example {
+
+// Declared in example_logger_console.hpp, which is not included here: the
+// static initializer of <iostream> would end up in the library.
+EXAMPLE_API Counter g_consoleLoggerMessages("example_console_logger_messages_total",
+                                            "Number of messages logged to the console.");
+EXAMPLE_API Counter g_consoleLoggerBytes("example_console_logger_bytes_total", "Number of bytes logged to the console.");
+
+} // namespace Example
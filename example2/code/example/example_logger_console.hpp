@@ -1,14 +1,31 @@
 #pragma once
 
+#include <iostream>
+
+#include <example/example_api.hpp>
 #include <example/example_logger.hpp>
+#include <example/example_metrics.hpp>
+#include <example/example_trace.hpp>
 
 namespace Example {
 
+EXAMPLE_API extern Counter g_consoleLoggerMessages;
+EXAMPLE_API extern Counter g_consoleLoggerBytes;
+
 class ConsoleLogger : public ILogger {
   public:
 	static std::unique_ptr<ConsoleLogger> create() { return std::unique_ptr<ConsoleLogger>(new ConsoleLogger); }
 
-	void log(std::string_view message) override { std::cout << message << "\n"; }
+	void log(std::string_view message) override
+	{
+		traceCall("Example::ConsoleLogger::log", [&] {
+			std::cout << message << "\n";
+			g_consoleLoggerMessages.add();
+			g_consoleLoggerBytes.add(message.size() + 1);
+		});
+	}
+
+	void flush() override { std::cout.flush(); }
 
   private:
 	ConsoleLogger() = default;
@@ -0,0 +1,8 @@
+#include <example/example_logger_file.hpp>
+
+namespace Example {
+
+Counter g_fileLoggerMessages("example_file_logger_messages_total", "Number of messages logged to files.");
+Counter g_fileLoggerBytes("example_file_logger_bytes_total", "Number of bytes logged to files.");
+
+} // namespace Example
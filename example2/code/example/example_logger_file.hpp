@@ -1,31 +1,132 @@
 #pragma once
 
+#include <mutex>
+
+#include <example/example_api.hpp>
 #include <example/example_logger.hpp>
+#include <example/example_metrics.hpp>
+#include <example/example_status.hpp>
+#include <example/example_trace.hpp>
+
+#if defined(__SANITIZE_THREAD__)
+#define EXAMPLE_LOGGER_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define EXAMPLE_LOGGER_TSAN 1
+#endif
+#endif
+#if !defined(EXAMPLE_LOGGER_TSAN)
+#define EXAMPLE_LOGGER_TSAN 0
+#endif
 
 namespace Example {
 
+EXAMPLE_API extern Counter g_fileLoggerMessages;
+EXAMPLE_API extern Counter g_fileLoggerBytes;
+
+// FileLogger writes through a plain C stream rather than std::ofstream, keeping
+// iostream out of the startup path. Each line is written under the stream's
+// lock, lines logged by concurrent threads don't interleave.
 class FileLogger : public ILogger {
   public:
-	static std::unique_ptr<FileLogger> create(std::string_view filename)
+	// create opens the log file immediately and fails if it cannot be created.
+	static Status create(std::unique_ptr<FileLogger>& outLogger, std::string_view filename)
 	{
 		std::unique_ptr<FileLogger> logger(new FileLogger(filename));
-		if (!logger->isValid()) {
-			return nullptr;
+		if (!logger->open()) {
+			return EXAMPLE_STATUS(StatusCode::IoError, "Could not create log file");
 		}
-		return logger;
+		outLogger = std::move(logger);
+		return {};
+	}
+
+	// createLazy defers opening the log file until the first message arrives.
+	// Short-lived invocations that never log don't pay for creating the file.
+	static std::unique_ptr<FileLogger> createLazy(std::string_view filename)
+	{
+		return std::unique_ptr<FileLogger>(new FileLogger(filename));
+	}
+
+	~FileLogger() noexcept
+	{
+		if (std::FILE* file = m_file.load(std::memory_order_acquire)) {
+			std::fclose(file);
+		}
+	}
+
+	FileLogger(const FileLogger&) = delete;
+	FileLogger& operator=(const FileLogger&) = delete;
+
+	void log(std::string_view message) override
+	{
+		traceCall("Example::FileLogger::log", [&] {
+			std::FILE* file = m_file.load(std::memory_order_acquire);
+			if (!file) [[unlikely]] {
+				std::call_once(m_openLazilyFlag, [this] { openLazily(); });
+				file = m_file.load(std::memory_order_acquire);
+				if (!file) {
+					return;
+				}
+			}
+			writeLine(file, message);
+			g_fileLoggerMessages.add();
+			g_fileLoggerBytes.add(message.size() + 1);
+		});
 	}
 
-	void log(std::string_view message) override { m_file << message << "\n"; }
+	void flush() override
+	{
+		if (std::FILE* file = m_file.load(std::memory_order_acquire)) {
+			std::fflush(file);
+		}
+	}
 
 	const std::string& filename() const { return m_filename; }
 
   private:
-	FileLogger(std::string_view filename) : m_filename(filename), m_file(m_filename) {}
+	FileLogger(std::string_view filename) : m_filename(filename) {}
+
+	bool open()
+	{
+		std::FILE* file = std::fopen(m_filename.c_str(), "w");
+		m_file.store(file, std::memory_order_release);
+		return file != nullptr;
+	}
 
-	bool isValid() const { return bool(m_file); }
+	// Lazily opened loggers have nobody to report failure to but the user.
+	// This runs once, failure would otherwise be reported for every message.
+	void openLazily()
+	{
+		if (!open()) {
+			fmt::print(stderr, "Could not create log file: {}\n", m_filename);
+		}
+	}
+
+	static void writeLine(std::FILE* file, std::string_view message)
+	{
+#if defined(_WIN32)
+		_lock_file(file);
+		_fwrite_nolock(message.data(), 1, message.size(), file);
+		_fputc_nolock('\n', file);
+		_unlock_file(file);
+#elif defined(__GLIBC__) && !EXAMPLE_LOGGER_TSAN
+		flockfile(file);
+		fwrite_unlocked(message.data(), 1, message.size(), file);
+		putc_unlocked('\n', file);
+		funlockfile(file);
+#else
+		// ThreadSanitizer does not know about the stream lock and would report
+		// the unlocked functions, the locked ones simply lock it recursively.
+		flockfile(file);
+		std::fwrite(message.data(), 1, message.size(), file);
+		std::fputc('\n', file);
+		funlockfile(file);
+#endif
+	}
 
 	std::string m_filename;
-	std::ofstream m_file;
+	std::atomic<std::FILE*> m_file = nullptr;
+	std::once_flag m_openLazilyFlag;
 };
 
 } // namespace Example
@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_logger_file.hpp>
+#include <example/example_mapped_file.hpp>
+
+using namespace Example;
+
+TEST_CASE("file logger lines from concurrent threads", "[logger]")
+{
+	const auto filename = "example_logger_file.test.log";
+	{
+		// All threads log their first message at the same time, racing to
+		// open the file.
+		const auto logger = FileLogger::createLazy(filename);
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 4; i++) {
+			threads.emplace_back([&logger, i] {
+				const std::string message(64, char('a' + i));
+				for (int j = 0; j < 1000; j++) {
+					logger->log(message);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}
+	{
+		const auto file = MappedFile::open(filename);
+		REQUIRE(file);
+		std::string_view content = file->data();
+		REQUIRE(content.size() == 4 * 1000 * 65);
+		while (!content.empty()) {
+			// Each line consists of a single thread's character.
+			REQUIRE(content[64] == '\n');
+			REQUIRE(content.find_first_not_of(content[0]) == 64);
+			content.remove_prefix(65);
+		}
+	}
+	std::remove(filename);
+}
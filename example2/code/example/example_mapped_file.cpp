@@ -0,0 +1,90 @@
+#include <example/example_mapped_file.hpp>
+
+#include <example/example_defer.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define EXAMPLE_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define EXAMPLE_HAS_MMAP 0
+#endif
+
+namespace Example {
+
+#if EXAMPLE_HAS_MMAP
+
+std::unique_ptr<MappedFile> MappedFile::open(std::string_view filename)
+{
+	const int fd = ::open(std::string(filename).c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return nullptr;
+	}
+	// The mapping stays valid after closing the descriptor.
+	EXAMPLE_DEFER(close(fd));
+
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		return nullptr;
+	}
+
+	std::unique_ptr<MappedFile> file(new MappedFile);
+	file->m_size = std::size_t(info.st_size);
+
+	// Mapping an empty file is an error, there's nothing to map anyway.
+	if (file->m_size > 0) {
+		void* data = mmap(nullptr, file->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			return nullptr;
+		}
+		// Inputs are consumed front to back, let the kernel read ahead
+		// aggressively and drop pages behind us.
+		madvise(data, file->m_size, MADV_SEQUENTIAL);
+		file->m_data = static_cast<const char*>(data);
+	}
+
+	return file;
+}
+
+MappedFile::~MappedFile() noexcept
+{
+	if (m_data) {
+		munmap(const_cast<char*>(m_data), m_size);
+	}
+}
+
+#else
+
+std::unique_ptr<MappedFile> MappedFile::open(std::string_view filename)
+{
+	std::FILE* stream = std::fopen(std::string(filename).c_str(), "rb");
+	if (!stream) {
+		return nullptr;
+	}
+
+	std::unique_ptr<MappedFile> file(new MappedFile);
+	if (std::fseek(stream, 0, SEEK_END) == 0) {
+		const long size = std::ftell(stream);
+		if (size > 0) {
+			file->m_buffer.reset(new char[std::size_t(size)]);
+			std::rewind(stream);
+			file->m_size = std::fread(file->m_buffer.get(), 1, std::size_t(size), stream);
+			file->m_data = file->m_buffer.get();
+		}
+	}
+
+	const bool failed = std::ferror(stream) != 0;
+	std::fclose(stream);
+	if (failed) {
+		return nullptr;
+	}
+	return file;
+}
+
+MappedFile::~MappedFile() noexcept = default;
+
+#endif
+
+} // namespace Example
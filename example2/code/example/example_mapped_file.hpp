@@ -0,0 +1,30 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// MappedFile provides read-only access to a file's content. The file is mapped
+// into memory where the platform supports it, which avoids copying the content
+// around. On other platforms the file is read into a buffer once.
+class EXAMPLE_API MappedFile {
+  public:
+	static std::unique_ptr<MappedFile> open(std::string_view filename);
+
+	~MappedFile() noexcept;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// The returned view stays valid for the lifetime of the MappedFile.
+	std::string_view data() const { return {m_data, m_size}; }
+
+  private:
+	MappedFile() = default;
+
+	const char* m_data = nullptr;
+	std::size_t m_size = 0;
+	std::unique_ptr<char[]> m_buffer; // <- only used without mmap support
+};
+
+} // namespace Example
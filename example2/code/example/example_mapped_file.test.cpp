@@ -0,0 +1,28 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_mapped_file.hpp>
+
+using namespace Example;
+
+TEST_CASE("mapped file", "[mapped_file]")
+{
+	const auto filename = "example_mapped_file.test.txt";
+	{
+		std::FILE* stream = std::fopen(filename, "wb");
+		REQUIRE(stream);
+		std::fputs("Tim\nTom\n", stream);
+		std::fclose(stream);
+	}
+
+	auto file = MappedFile::open(filename);
+	REQUIRE(file);
+	REQUIRE(file->data() == "Tim\nTom\n");
+
+	file.reset();
+	std::remove(filename);
+}
+
+TEST_CASE("mapped file missing", "[mapped_file]")
+{
+	REQUIRE(!MappedFile::open("does/not/exist.txt"));
+}
@@ -0,0 +1,165 @@
+#include <example/example_metrics.hpp>
+
+namespace Example {
+
+static constinit std::atomic<Metric*> g_firstMetric = nullptr;
+
+Metric::Metric(Type type, const char* name, const char* help) : m_type(type), m_name(name), m_help(help)
+{
+	m_next = g_firstMetric.load(std::memory_order_relaxed);
+	while (!g_firstMetric.compare_exchange_weak(m_next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+Metric* Metric::first()
+{
+	return g_firstMetric.load(std::memory_order_acquire);
+}
+
+unsigned currentMetricShard()
+{
+	static constinit std::atomic<unsigned> nextShard = 0;
+	thread_local const unsigned shard = nextShard.fetch_add(1, std::memory_order_relaxed) % Counter::ShardCount;
+	return shard;
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other)
+{
+	for (unsigned i = 0; i < BucketCount; i++) {
+		buckets[i] += other.buckets[i];
+	}
+	count += other.count;
+	sum += other.sum;
+	min = std::min(min, other.min);
+	max = std::max(max, other.max);
+}
+
+std::uint64_t HistogramSnapshot::percentile(double percentile) const
+{
+	if (count == 0) {
+		return 0;
+	}
+
+	const auto rank = std::uint64_t(std::ceil(percentile / 100.0 * double(count)));
+	std::uint64_t seen = 0;
+	for (unsigned i = 0; i < BucketCount; i++) {
+		seen += buckets[i];
+		if (seen >= std::max<std::uint64_t>(rank, 1)) {
+			return std::min(bucketUpperBound(i), max);
+		}
+	}
+	return max;
+}
+
+HistogramSnapshot Histogram::snapshot() const
+{
+	HistogramSnapshot snapshot;
+	for (const Shard& shard : m_shards) {
+		for (unsigned i = 0; i < HistogramSnapshot::BucketCount; i++) {
+			const std::uint64_t count = load(shard.buckets[i]);
+			snapshot.buckets[i] += count;
+			snapshot.count += count;
+		}
+		snapshot.sum += load(shard.sum);
+		snapshot.min = std::min(snapshot.min, ~load(shard.minComplement));
+		snapshot.max = std::max(snapshot.max, load(shard.max));
+	}
+	return snapshot;
+}
+
+void writeMetricsText(std::string& out)
+{
+	auto inserter = std::back_inserter(out);
+	for (const Metric* metric = Metric::first(); metric; metric = metric->next()) {
+		switch (metric->type()) {
+		case Metric::Type::Counter:
+			fmt::format_to(inserter, "{} {}\n", metric->name(), static_cast<const Counter*>(metric)->value());
+			break;
+		case Metric::Type::Gauge:
+			fmt::format_to(inserter, "{} {}\n", metric->name(), static_cast<const Gauge*>(metric)->value());
+			break;
+		case Metric::Type::Histogram: {
+			const auto& histogram = *static_cast<const Histogram*>(metric);
+			const auto snapshot = histogram.snapshot();
+			const double scale = histogram.scale();
+			fmt::format_to(inserter, "{} count={} mean={:.4g} p50={:.4g} p99={:.4g} p99.9={:.4g} max={:.4g}\n",
+			               metric->name(), snapshot.count, snapshot.mean() / scale,
+			               double(snapshot.percentile(50.0)) / scale, double(snapshot.percentile(99.0)) / scale,
+			               double(snapshot.percentile(99.9)) / scale, double(snapshot.max) / scale);
+			break;
+		}
+		}
+	}
+}
+
+// Histograms are exported with power of two bucket boundaries, the fine
+// grained buckets would result in thousands of series. All boundaries are
+// written on every export such that the set of series does not depend on the
+// recorded values. Boundaries and sum are converted to the base unit.
+static void writeHistogramPrometheus(std::string& out, const Histogram& histogram)
+{
+	auto inserter = std::back_inserter(out);
+	const char* name = histogram.name();
+	const auto snapshot = histogram.snapshot();
+	std::uint64_t cumulative = 0;
+	unsigned bucket = 0;
+	for (unsigned exponent = 0; exponent < 64; exponent++) {
+		const std::uint64_t bound = (std::uint64_t(1) << exponent) - 1;
+		for (; bucket < HistogramSnapshot::BucketCount && HistogramSnapshot::bucketUpperBound(bucket) <= bound;
+		     bucket++) {
+			cumulative += snapshot.buckets[bucket];
+		}
+		fmt::format_to(inserter, "{}_bucket{{le=\"{}\"}} {}\n", name, double(bound) / histogram.scale(), cumulative);
+	}
+	fmt::format_to(inserter, "{}_bucket{{le=\"+Inf\"}} {}\n", name, snapshot.count);
+	fmt::format_to(inserter, "{}_sum {}\n", name, double(snapshot.sum) / histogram.scale());
+	fmt::format_to(inserter, "{}_count {}\n", name, snapshot.count);
+}
+
+void writeMetricsPrometheus(std::string& out)
+{
+	auto inserter = std::back_inserter(out);
+	for (const Metric* metric = Metric::first(); metric; metric = metric->next()) {
+		fmt::format_to(inserter, "# HELP {} {}\n", metric->name(), metric->help());
+		switch (metric->type()) {
+		case Metric::Type::Counter:
+			fmt::format_to(inserter, "# TYPE {} counter\n", metric->name());
+			fmt::format_to(inserter, "{} {}\n", metric->name(), static_cast<const Counter*>(metric)->value());
+			break;
+		case Metric::Type::Gauge:
+			fmt::format_to(inserter, "# TYPE {} gauge\n", metric->name());
+			fmt::format_to(inserter, "{} {}\n", metric->name(), static_cast<const Gauge*>(metric)->value());
+			break;
+		case Metric::Type::Histogram:
+			fmt::format_to(inserter, "# TYPE {} histogram\n", metric->name());
+			writeHistogramPrometheus(out, *static_cast<const Histogram*>(metric));
+			break;
+		}
+	}
+}
+
+bool writeMetricsFile(std::string_view filename)
+{
+	std::string content;
+	if (filename.ends_with(".prom")) {
+		writeMetricsPrometheus(content);
+	}
+	else {
+		writeMetricsText(content);
+	}
+
+	const std::string temporaryFilename = std::string(filename) + ".tmp";
+	std::FILE* file = std::fopen(temporaryFilename.c_str(), "wb");
+	if (!file) {
+		return false;
+	}
+	bool failed = std::fwrite(content.data(), 1, content.size(), file) != content.size();
+	failed |= std::fclose(file) != 0;
+
+#if defined(_WIN32)
+	// std::rename doesn't replace existing files on Windows.
+	std::remove(std::string(filename).c_str());
+#endif
+	return !failed && std::rename(temporaryFilename.c_str(), std::string(filename).c_str()) == 0;
+}
+
+} // namespace Example
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// Metrics are global objects with static storage duration, other storage is
+// not supported. Each metric adds itself to a lock-free registry on
+// construction, from which all metrics can be enumerated and exported. Metrics
+// are never removed from the registry.
+//
+// Updating a counter or gauge is a single relaxed atomic operation. Counters
+// are sharded across cache lines such that threads don't contend for the same
+// line, the shards are summed up when reading the value. Recording into a
+// histogram takes several relaxed atomic operations: it increments a bucket,
+// adds to the sum and updates the minimum and maximum, the latter in
+// compare-exchange loops that retry only if the value is a new extreme.
+// Histograms are sharded like counters, the shards are merged when taking a
+// snapshot. Their shards are not touched on construction but rely on the zero
+// initialization of static storage: only pages of shards that are recorded to
+// get mapped, a process with a few threads pays for a few shards.
+
+class EXAMPLE_API Metric {
+  public:
+	enum class Type { Counter, Gauge, Histogram };
+
+	Metric(const Metric&) = delete;
+	Metric& operator=(const Metric&) = delete;
+
+	Type type() const { return m_type; }
+	const char* name() const { return m_name; }
+	const char* help() const { return m_help; }
+
+	// Registry access, the most recently constructed metric comes first.
+	static Metric* first();
+	Metric* next() const { return m_next; }
+
+  protected:
+	Metric(Type type, const char* name, const char* help);
+	~Metric() noexcept = default;
+
+  private:
+	Type m_type;
+	const char* m_name;
+	const char* m_help;
+	Metric* m_next = nullptr;
+};
+
+// Assigns threads round-robin to one of the counter shards.
+EXAMPLE_API unsigned currentMetricShard();
+
+class EXAMPLE_API Counter : public Metric {
+  public:
+	static constexpr unsigned ShardCount = 16;
+
+	Counter(const char* name, const char* help) : Metric(Type::Counter, name, help) {}
+
+	void add(std::uint64_t value = 1)
+	{
+		m_shards[currentMetricShard()].value.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	std::uint64_t value() const
+	{
+		std::uint64_t sum = 0;
+		for (const Shard& shard : m_shards) {
+			sum += shard.value.load(std::memory_order_relaxed);
+		}
+		return sum;
+	}
+
+  private:
+	struct alignas(64) Shard {
+		std::atomic<std::uint64_t> value = 0;
+	};
+	Shard m_shards[ShardCount];
+};
+
+class EXAMPLE_API Gauge : public Metric {
+  public:
+	Gauge(const char* name, const char* help) : Metric(Type::Gauge, name, help) {}
+
+	void set(std::int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+	void add(std::int64_t value) { m_value.fetch_add(value, std::memory_order_relaxed); }
+
+	std::int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+  private:
+	std::atomic<std::int64_t> m_value = 0;
+};
+
+// HistogramSnapshot holds the bucket counts of a Histogram at some point in
+// time. Buckets are log-linear: values below 2^SubBucketBits get a bucket each,
+// above that every power of two is split into 2^SubBucketBits buckets. Each
+// bucket thereby covers a range of at most 1/2^SubBucketBits of its values.
+//
+// Snapshots of different histograms (e.g. one per thread or process) can be
+// merged.
+struct EXAMPLE_API HistogramSnapshot {
+	static constexpr unsigned SubBucketBits = 5;
+	static constexpr unsigned SubBucketCount = 1u << SubBucketBits;
+	static constexpr unsigned BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+	static unsigned bucketIndex(std::uint64_t value)
+	{
+		const unsigned exponent = unsigned(std::bit_width(value | 1)) - 1;
+		if (exponent < SubBucketBits) {
+			return unsigned(value);
+		}
+		const unsigned shift = exponent - SubBucketBits;
+		return (shift + 1) * SubBucketCount + unsigned((value >> shift) - SubBucketCount);
+	}
+
+	static std::uint64_t bucketLowerBound(unsigned index)
+	{
+		if (index < SubBucketCount) {
+			return index;
+		}
+		const unsigned shift = index / SubBucketCount - 1;
+		return std::uint64_t(SubBucketCount + index % SubBucketCount) << shift;
+	}
+
+	static std::uint64_t bucketUpperBound(unsigned index)
+	{
+		if (index < SubBucketCount) {
+			return index;
+		}
+		const unsigned shift = index / SubBucketCount - 1;
+		return bucketLowerBound(index) + ((std::uint64_t(1) << shift) - 1);
+	}
+
+	// Records a value without synchronization, for histograms owned by a
+	// single thread.
+	void record(std::uint64_t value)
+	{
+		buckets[bucketIndex(value)]++;
+		count++;
+		sum += value;
+		min = std::min(min, value);
+		max = std::max(max, value);
+	}
+
+	void merge(const HistogramSnapshot& other);
+
+	// Returns the upper bound of the bucket containing the given percentile
+	// (0-100), clamped to the maximum recorded value.
+	std::uint64_t percentile(double percentile) const;
+
+	double mean() const { return count ? double(sum) / double(count) : 0.0; }
+
+	std::array<std::uint64_t, BucketCount> buckets = {};
+	std::uint64_t count = 0;
+	std::uint64_t sum = 0;
+	std::uint64_t min = UINT64_MAX;
+	std::uint64_t max = 0;
+};
+
+class EXAMPLE_API Histogram : public Metric {
+  public:
+	static constexpr unsigned ShardCount = Counter::ShardCount;
+
+	// Values are recorded as integers and divided by scale when exported, to
+	// convert them to the metric's base unit (e.g. 1e9 for durations recorded
+	// in nanoseconds and exported in seconds).
+	Histogram(const char* name, const char* help, double scale = 1.0)
+	    : Metric(Type::Histogram, name, help), m_scale(scale)
+	{}
+
+	double scale() const { return m_scale; }
+
+	void record(std::uint64_t value)
+	{
+		Shard& shard = m_shards[currentMetricShard()];
+		std::atomic_ref(shard.buckets[HistogramSnapshot::bucketIndex(value)]).fetch_add(1, std::memory_order_relaxed);
+		std::atomic_ref(shard.sum).fetch_add(value, std::memory_order_relaxed);
+
+		// The minimum is stored as its complement, which starts out as 0.
+		const std::uint64_t minComplement = ~value;
+		std::atomic_ref minRef(shard.minComplement);
+		std::uint64_t min = minRef.load(std::memory_order_relaxed);
+		while (minComplement > min && !minRef.compare_exchange_weak(min, minComplement, std::memory_order_relaxed)) {}
+		std::atomic_ref maxRef(shard.max);
+		std::uint64_t max = maxRef.load(std::memory_order_relaxed);
+		while (value > max && !maxRef.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+	}
+
+	// Buckets are read one by one while other threads may still record; the
+	// snapshot is consistent in itself, but not necessarily a single point in
+	// time.
+	HistogramSnapshot snapshot() const;
+
+  private:
+	// Plain integers accessed through std::atomic_ref: std::atomic members
+	// would be zeroed by the constructor, touching every page.
+	struct alignas(64) Shard {
+		std::uint64_t buckets[HistogramSnapshot::BucketCount];
+		std::uint64_t sum;
+		std::uint64_t minComplement;
+		std::uint64_t max;
+	};
+	static_assert(std::is_trivially_default_constructible_v<Shard>);
+
+	// std::atomic_ref of a const object is not supported before C++26.
+	static std::uint64_t load(const std::uint64_t& value)
+	{
+		return std::atomic_ref(const_cast<std::uint64_t&>(value)).load(std::memory_order_relaxed);
+	}
+
+	double m_scale;
+	Shard m_shards[ShardCount];
+};
+
+// ScopedTimer records the time spent in the current scope, in nanoseconds.
+class ScopedTimer {
+  public:
+	explicit ScopedTimer(Histogram& histogram) : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+	~ScopedTimer() noexcept
+	{
+		const auto duration = std::chrono::steady_clock::now() - m_start;
+		m_histogram.record(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+	}
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+	Histogram& m_histogram;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+// Appends all registered metrics as human readable text, one line per metric.
+// Histogram values are converted to their base unit.
+EXAMPLE_API void writeMetricsText(std::string& out);
+
+// Appends all registered metrics in the Prometheus text exposition format.
+EXAMPLE_API void writeMetricsPrometheus(std::string& out);
+
+// Writes all metrics to the given file. Files ending in .prom use the
+// Prometheus format, all others the text format. The file is replaced
+// atomically, readers never see a partially written file.
+EXAMPLE_API bool writeMetricsFile(std::string_view filename);
+
+} // namespace Example
@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_metrics.hpp>
+
+using namespace Example;
+
+static Counter g_testCounter("example_test_counter_total", "Counter used for testing.");
+static Histogram g_testHistogram("example_test_histogram", "Histogram used for testing.");
+static Histogram g_testDuration("example_test_duration_seconds", "Duration used for testing.", 1e9);
+
+TEST_CASE("metrics counter across threads", "[metrics]")
+{
+	const auto before = g_testCounter.value();
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; i++) {
+		threads.emplace_back([] {
+			for (int j = 0; j < 1000; j++) {
+				g_testCounter.add();
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	REQUIRE(g_testCounter.value() - before == 4000);
+}
+
+TEST_CASE("metrics histogram across threads", "[metrics]")
+{
+	const auto before = g_testHistogram.snapshot();
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; i++) {
+		threads.emplace_back([i] {
+			for (std::uint64_t j = 1; j <= 1000; j++) {
+				g_testHistogram.record(j * std::uint64_t(i + 1));
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	const auto after = g_testHistogram.snapshot();
+	REQUIRE(after.count - before.count == 4000);
+	REQUIRE(after.sum - before.sum == 500500 * (1 + 2 + 3 + 4));
+	REQUIRE(after.min <= 1);
+	REQUIRE(after.max >= 4000);
+}
+
+TEST_CASE("metrics histogram buckets", "[metrics]")
+{
+	for (std::uint64_t value : std::initializer_list<std::uint64_t>{0, 1, 31, 32, 33, 1000, 123456789, UINT64_MAX}) {
+		const unsigned index = HistogramSnapshot::bucketIndex(value);
+		REQUIRE(index < HistogramSnapshot::BucketCount);
+		REQUIRE(HistogramSnapshot::bucketLowerBound(index) <= value);
+		REQUIRE(value <= HistogramSnapshot::bucketUpperBound(index));
+	}
+}
+
+TEST_CASE("metrics histogram percentiles", "[metrics]")
+{
+	HistogramSnapshot a;
+	HistogramSnapshot b;
+	for (std::uint64_t i = 1; i <= 100; i++) {
+		(i % 2 ? a : b).buckets[HistogramSnapshot::bucketIndex(i * 1000)]++;
+		(i % 2 ? a : b).count++;
+	}
+	a.max = 99000;
+	b.max = 100000;
+
+	a.merge(b);
+	REQUIRE(a.count == 100);
+	REQUIRE(a.max == 100000);
+
+	// Buckets are at most 1/32 of their values wide.
+	REQUIRE(a.percentile(50.0) >= 50000);
+	REQUIRE(a.percentile(50.0) <= 50000 + 50000 / 32);
+	REQUIRE(a.percentile(100.0) == 100000);
+}
+
+TEST_CASE("metrics histogram snapshot recording", "[metrics]")
+{
+	HistogramSnapshot snapshot;
+	for (std::uint64_t i = 1; i <= 1000; i++) {
+		snapshot.record(i);
+	}
+
+	REQUIRE(snapshot.count == 1000);
+	REQUIRE(snapshot.min == 1);
+	REQUIRE(snapshot.max == 1000);
+	REQUIRE(snapshot.mean() == 500.5);
+	REQUIRE(snapshot.percentile(99.0) >= 990);
+	REQUIRE(snapshot.percentile(99.0) <= 990 + 990 / 32);
+}
+
+TEST_CASE("metrics export", "[metrics]")
+{
+	g_testHistogram.record(1000);
+
+	std::string text;
+	writeMetricsText(text);
+	REQUIRE(text.find("example_test_counter_total ") != std::string::npos);
+	REQUIRE(text.find("example_test_histogram count=") != std::string::npos);
+
+	std::string prometheus;
+	writeMetricsPrometheus(prometheus);
+	REQUIRE(prometheus.find("# TYPE example_test_counter_total counter") != std::string::npos);
+	REQUIRE(prometheus.find("example_test_histogram_bucket{le=\"+Inf\"}") != std::string::npos);
+}
+
+TEST_CASE("metrics prometheus histogram buckets are fixed", "[metrics]")
+{
+	const auto countBuckets = [](const std::string& prometheus) {
+		std::size_t count = 0;
+		for (auto pos = prometheus.find("example_test_duration_seconds_bucket{"); pos != std::string::npos;
+		     pos = prometheus.find("example_test_duration_seconds_bucket{", pos + 1)) {
+			count++;
+		}
+		return count;
+	};
+
+	std::string empty;
+	writeMetricsPrometheus(empty);
+
+	g_testDuration.record(1'000'000'000);
+	std::string recorded;
+	writeMetricsPrometheus(recorded);
+
+	// 64 power of two bounds plus +Inf, independent of the recorded values.
+	REQUIRE(countBuckets(empty) == 65);
+	REQUIRE(countBuckets(recorded) == 65);
+
+	// Nanoseconds are exported as seconds.
+	REQUIRE(recorded.find("example_test_duration_seconds_bucket{le=\"0\"} 0") != std::string::npos);
+	REQUIRE(recorded.find("example_test_duration_seconds_bucket{le=\"1e-09\"} 0") != std::string::npos);
+	REQUIRE(recorded.find("example_test_duration_seconds_sum 1\n") != std::string::npos);
+}
@@ -0,0 +1,192 @@
+#include <example/example_output.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define EXAMPLE_HAS_POSIX_IO 1
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define EXAMPLE_HAS_POSIX_IO 0
+#endif
+
+#if defined(__linux__)
+#define EXAMPLE_HAS_VMSPLICE 1
+#include <fcntl.h>
+#include <sys/uio.h>
+#else
+#define EXAMPLE_HAS_VMSPLICE 0
+#endif
+
+namespace Example {
+
+// Buffers are mapped directly rather than taken from the heap. Spliced pages
+// are referenced by the pipe, releasing a mapping keeps its content intact
+// for the reader while heap memory may get reused right away.
+static char* allocateBuffer()
+{
+#if EXAMPLE_HAS_POSIX_IO
+	void* buffer = mmap(nullptr, OutputWriter::BufferSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return buffer == MAP_FAILED ? nullptr : static_cast<char*>(buffer);
+#else
+	return static_cast<char*>(::operator new(OutputWriter::BufferSize, std::align_val_t(4096), std::nothrow));
+#endif
+}
+
+static void freeBuffer(char* buffer)
+{
+#if EXAMPLE_HAS_POSIX_IO
+	munmap(buffer, OutputWriter::BufferSize);
+#else
+	::operator delete(buffer, std::align_val_t(4096));
+#endif
+}
+
+std::unique_ptr<OutputWriter> OutputWriter::create(std::FILE* stream)
+{
+	std::unique_ptr<OutputWriter> writer(new OutputWriter(stream));
+	if (!writer->m_buffer) {
+		return nullptr;
+	}
+	return writer;
+}
+
+OutputWriter::OutputWriter(std::FILE* stream) : m_stream(stream)
+{
+	m_buffer = allocateBuffer();
+
+	std::fflush(m_stream);
+
+#if EXAMPLE_HAS_POSIX_IO
+	m_fd = fileno(m_stream);
+#endif
+
+#if EXAMPLE_HAS_VMSPLICE
+	// Only blocking pipes qualify, vmsplice must not give up on a full pipe.
+	// Growing the pipe to a whole buffer saves wakeups, it may fail due to
+	// system limits.
+	struct stat info;
+	if (fstat(m_fd, &info) == 0 && S_ISFIFO(info.st_mode) && !(fcntl(m_fd, F_GETFL) & O_NONBLOCK)) {
+		fcntl(m_fd, F_SETPIPE_SZ, int(BufferSize));
+		m_splice = true;
+	}
+#endif
+}
+
+OutputWriter::~OutputWriter() noexcept
+{
+	flush();
+	if (m_buffer) {
+		freeBuffer(m_buffer);
+	}
+}
+
+bool OutputWriter::flush()
+{
+	if (m_failed) {
+		return false;
+	}
+
+	// Partially filled buffers are always copied, the buffer can be reused
+	// right away.
+	if (m_size > 0) {
+		m_failed = !writeAll(m_buffer, m_size);
+	}
+	m_size = 0;
+	return !m_failed;
+}
+
+void OutputWriter::writeSlow(std::string_view data)
+{
+	if (m_failed) {
+		return;
+	}
+
+	while (!data.empty()) {
+		const std::size_t count = std::min(data.size(), BufferSize - m_size);
+		std::memcpy(m_buffer + m_size, data.data(), count);
+		m_size += count;
+		data.remove_prefix(count);
+
+		if (m_size == BufferSize) {
+			submitFullBuffer();
+		}
+	}
+}
+
+void OutputWriter::submitFullBuffer()
+{
+	if (!m_failed) {
+		if (m_splice) {
+			m_failed = !spliceAll(m_buffer, m_size);
+		}
+		else {
+			m_failed = !writeAll(m_buffer, m_size);
+		}
+	}
+
+	// Pages of a spliced buffer may still be referenced, the mapping is
+	// replaced rather than written to again. If that fails, the buffer stays
+	// full such that writes end up in writeSlow, which discards them.
+	if (m_spliced) {
+		m_spliced = false;
+		char* buffer = allocateBuffer();
+		if (!buffer) {
+			m_failed = true;
+			return;
+		}
+		freeBuffer(m_buffer);
+		m_buffer = buffer;
+	}
+	m_size = 0;
+}
+
+bool OutputWriter::writeAll(const char* data, std::size_t size)
+{
+#if EXAMPLE_HAS_POSIX_IO
+	while (size > 0) {
+		const auto count = ::write(m_fd, data, size);
+		if (count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		data += count;
+		size -= std::size_t(count);
+	}
+	return true;
+#else
+	return std::fwrite(data, 1, size, m_stream) == size && std::fflush(m_stream) == 0;
+#endif
+}
+
+bool OutputWriter::spliceAll(const char* data, std::size_t size)
+{
+#if EXAMPLE_HAS_VMSPLICE
+	while (size > 0) {
+		iovec iov = {const_cast<char*>(data), size};
+		const auto count = vmsplice(m_fd, &iov, 1, 0);
+		if (count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			// vmsplice might not be supported for this pipe, fall back to
+			// copying.
+			if (errno == EINVAL || errno == ENOSYS) {
+				m_splice = false;
+				return writeAll(data, size);
+			}
+			return false;
+		}
+		m_spliced = true;
+		data += count;
+		size -= std::size_t(count);
+	}
+	return true;
+#else
+	return writeAll(data, size);
+#endif
+}
+
+} // namespace Example
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// OutputWriter assembles output in large page-aligned buffers and passes them
+// on to the operating system in big chunks, rather than issuing a system call
+// per result.
+//
+// When the output is a pipe on Linux, full buffers are handed to the pipe with
+// vmsplice, which avoids copying them into the kernel. Pages handed off this
+// way are still referenced after they leave the pipe if the reader passes them
+// on with splice or tee, they must never be modified again. A spliced buffer
+// is therefore unmapped and replaced by a fresh mapping.
+//
+// Output written through the given stream's FILE interface (e.g. fmt::print)
+// is flushed on creation; it must not be mixed with the writer afterwards.
+class EXAMPLE_API OutputWriter {
+  public:
+	static constexpr std::size_t BufferSize = 1 << 20;
+
+	static std::unique_ptr<OutputWriter> create(std::FILE* stream);
+
+	~OutputWriter() noexcept;
+
+	OutputWriter(const OutputWriter&) = delete;
+	OutputWriter& operator=(const OutputWriter&) = delete;
+
+	void write(std::string_view data)
+	{
+		if (data.size() <= BufferSize - m_size) [[likely]] {
+			std::memcpy(m_buffer + m_size, data.data(), data.size());
+			m_size += data.size();
+			return;
+		}
+		writeSlow(data);
+	}
+
+	// Passes all buffered output on to the operating system.
+	bool flush();
+
+	// Returns true if writing failed at some point. Any further output is
+	// discarded in that case.
+	bool failed() const { return m_failed; }
+
+	// Returns true if full buffers are passed on using vmsplice.
+	bool usesSplice() const { return m_splice; }
+
+  private:
+	OutputWriter(std::FILE* stream);
+
+	void writeSlow(std::string_view data);
+	void submitFullBuffer();
+	bool writeAll(const char* data, std::size_t size);
+	bool spliceAll(const char* data, std::size_t size);
+
+	std::FILE* m_stream;
+	int m_fd = -1;
+	bool m_splice = false;
+	bool m_spliced = false; // <- pages of the current buffer are in the pipe
+	bool m_failed = false;
+
+	char* m_buffer = nullptr;
+	std::size_t m_size = 0;
+};
+
+} // namespace Example
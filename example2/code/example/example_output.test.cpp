@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+#include <example/example_output.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
+using namespace Example;
+
+// Generates several buffers worth of output with lines of varying size, such
+// that buffer boundaries fall in the middle of lines.
+static std::string makeOutput()
+{
+	std::string output;
+	for (int i = 0; output.size() < 3 * OutputWriter::BufferSize; i++) {
+		output += std::string(std::size_t(i % 97), char('a' + i % 26)) + "\n";
+	}
+	return output;
+}
+
+static void writeInChunks(OutputWriter& writer, std::string_view output)
+{
+	while (!output.empty()) {
+		const auto line = output.substr(0, output.find('\n') + 1);
+		writer.write(line);
+		output.remove_prefix(line.size());
+	}
+}
+
+TEST_CASE("output writer to file", "[output]")
+{
+	const auto expected = makeOutput();
+
+	std::FILE* stream = std::tmpfile();
+	REQUIRE(stream);
+	{
+		auto writer = OutputWriter::create(stream);
+		REQUIRE(writer);
+		writeInChunks(*writer, expected);
+		REQUIRE(writer->flush());
+	}
+
+	std::string actual(expected.size(), '\0');
+	std::rewind(stream);
+	REQUIRE(std::fread(actual.data(), 1, actual.size(), stream) == actual.size());
+	REQUIRE(actual == expected);
+	std::fclose(stream);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("output writer to pipe", "[output]")
+{
+	const auto expected = makeOutput();
+
+	int fds[2];
+	REQUIRE(pipe(fds) == 0);
+
+	// The reader is deliberately slow to start, such that the writer blocks on
+	// a full pipe.
+	std::string actual;
+	std::thread reader([&] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		char buffer[4096];
+		for (ssize_t count; (count = read(fds[0], buffer, sizeof(buffer))) > 0;) {
+			actual.append(buffer, std::size_t(count));
+		}
+	});
+
+	std::FILE* stream = fdopen(fds[1], "w");
+	REQUIRE(stream);
+	{
+		auto writer = OutputWriter::create(stream);
+		REQUIRE(writer);
+		writeInChunks(*writer, expected);
+		REQUIRE(writer->flush());
+	}
+	std::fclose(stream);
+
+	reader.join();
+	close(fds[0]);
+	REQUIRE(actual == expected);
+}
+#endif
+
+#if defined(__linux__)
+TEST_CASE("output writer to pipe forwarded with tee", "[output]")
+{
+	const auto expected = makeOutput();
+
+	int fds[2];
+	int forwardFds[2];
+	REQUIRE(pipe(fds) == 0);
+	REQUIRE(pipe(forwardFds) == 0);
+	fcntl(forwardFds[1], F_SETPIPE_SZ, int(OutputWriter::BufferSize));
+	const auto forwardSize = std::size_t(fcntl(forwardFds[1], F_GETPIPE_SZ));
+
+	// The reader duplicates the start of the output into a second pipe, which
+	// references the writer's pages, and consumes the rest. The second pipe is
+	// only read once the writer is done, it must not see later output.
+	std::string actual;
+	std::thread reader([&] {
+		char buffer[4096];
+		while (actual.size() < forwardSize) {
+			const auto count = tee(fds[0], forwardFds[1], forwardSize - actual.size(), 0);
+			if (count <= 0) {
+				break;
+			}
+			for (auto remaining = std::size_t(count); remaining > 0;) {
+				const auto read = ::read(fds[0], buffer, std::min(remaining, sizeof(buffer)));
+				if (read <= 0) {
+					return;
+				}
+				actual.append(buffer, std::size_t(read));
+				remaining -= std::size_t(read);
+			}
+		}
+		for (ssize_t count; (count = read(fds[0], buffer, sizeof(buffer))) > 0;) {
+			actual.append(buffer, std::size_t(count));
+		}
+	});
+
+	std::FILE* stream = fdopen(fds[1], "w");
+	REQUIRE(stream);
+	{
+		auto writer = OutputWriter::create(stream);
+		REQUIRE(writer);
+		writeInChunks(*writer, expected);
+		REQUIRE(writer->flush());
+	}
+	std::fclose(stream);
+
+	reader.join();
+	close(fds[0]);
+	REQUIRE(actual == expected);
+
+	close(forwardFds[1]);
+	std::string forwarded;
+	char buffer[4096];
+	for (ssize_t count; (count = read(forwardFds[0], buffer, sizeof(buffer))) > 0;) {
+		forwarded.append(buffer, std::size_t(count));
+	}
+	close(forwardFds[0]);
+	REQUIRE(forwarded == expected.substr(0, forwardSize));
+}
+#endif
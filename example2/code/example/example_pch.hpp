@@ -1,10 +1,25 @@
 #pragma once
 
-#include <fstream>
-#include <iostream>
+// Note that <iostream> is deliberately not part of the precompiled header. Its
+// static initializer would end up in every translation unit, which adds up for
+// an executable that is invoked thousands of times. Include it where needed.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <memory>
+#include <new>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include <fmt/core.h>
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <example/example_api.hpp>
+#include <example/example_status.hpp>
+
 namespace Example {
 
 // Platform illustrates how singletons with special requirements can be
@@ -8,19 +11,27 @@ namespace Example {
 //   functions
 // - The implementation must not use heap allocation
 // - The implementation can be replaced by a mock for testing purposes
-class Platform {
+class EXAMPLE_API Platform {
   public:
 	// This part is the platform interface:
 	virtual int cpuCount() = 0;
+
+	// Cache and memory topology, as seen from the first CPU. Sizes are in
+	// bytes, level 1 refers to the data cache. Unknown values are reported as
+	// 0.
+	virtual std::size_t cacheSize(int level) = 0;
+	virtual std::size_t cacheLineSize() = 0;
+	virtual int numaNodeCount() = 0;
 	virtual ~Platform() noexcept = default;
 
-	// These are the instance management functions:
-	static void initialize();
+	// These are the instance management functions. Initialization fails if a
+	// platform (or a mock) is set up already.
+	static Status initialize();
 	static void finalize();
 	static Platform& get() { return *sm_impl; }
 
   private:
-	static inline Platform* sm_impl;
+	static Platform* sm_impl;
 	friend class MockPlatform;
 };
 
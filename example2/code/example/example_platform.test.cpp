@@ -0,0 +1,27 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_platform.hpp>
+
+using namespace Example;
+
+TEST_CASE("platform topology", "[platform]")
+{
+	REQUIRE(Platform::initialize().ok());
+	REQUIRE(Platform::initialize().code() == StatusCode::AlreadyInitialized);
+	auto& platform = Platform::get();
+
+	REQUIRE(platform.cpuCount() >= 1);
+	REQUIRE(platform.numaNodeCount() >= 1);
+	REQUIRE((platform.cacheLineSize() == 0 || std::has_single_bit(platform.cacheLineSize())));
+
+	// Each cache level is larger than the previous one, where known.
+	for (int level = 2; level <= 4; level++) {
+		if (platform.cacheSize(level) && platform.cacheSize(level - 1)) {
+			REQUIRE(platform.cacheSize(level) > platform.cacheSize(level - 1));
+		}
+	}
+	REQUIRE(platform.cacheSize(0) == 0);
+	REQUIRE(platform.cacheSize(5) == 0);
+
+	Platform::finalize();
+}
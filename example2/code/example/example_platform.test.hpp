@@ -13,6 +13,13 @@ class MockPlatform : public Platform {
 
 	int cpuCount() override { return mockCpuCount; }
 	int mockCpuCount = 1;
+
+	std::size_t cacheSize(int level) override { return level >= 1 && level <= 3 ? mockCacheSizes[level - 1] : 0; }
+	std::size_t cacheLineSize() override { return mockCacheLineSize; }
+	int numaNodeCount() override { return mockNumaNodeCount; }
+	std::size_t mockCacheSizes[3] = {32 << 10, 1 << 20, 32 << 20};
+	std::size_t mockCacheLineSize = 64;
+	int mockNumaNodeCount = 1;
 };
 
 } // namespace Example
@@ -0,0 +1,162 @@
+#include <example/example_platform.hpp>
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <example/example_metrics.hpp>
+#include <example/example_trace.hpp>
+
+namespace Example {
+
+static Gauge g_platformInitialized("example_platform_initialized", "Whether the platform is currently initialized.");
+static Counter g_platformCpuCountCalls("example_platform_cpu_count_calls_total", "Number of Platform::cpuCount calls.");
+
+// Reads a small sysfs file into the given buffer and returns its first line.
+// Plain file descriptors are used, a FILE would be allocated on the heap.
+static std::string_view readFile(const char* path, char* buffer, std::size_t size)
+{
+	const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return {};
+	}
+	const ssize_t length = ::read(fd, buffer, size);
+	::close(fd);
+
+	std::string_view content(buffer, length > 0 ? std::size_t(length) : 0);
+	return content.substr(0, content.find('\n'));
+}
+
+// Parses sizes like "48K" or "8M", as found in the sysfs cache directories.
+static std::size_t parseSize(std::string_view text)
+{
+	std::size_t value = 0;
+	std::size_t i = 0;
+	for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+		value = value * 10 + std::size_t(text[i] - '0');
+	}
+	if (i < text.size()) {
+		switch (text[i]) {
+		case 'K': return value << 10;
+		case 'M': return value << 20;
+		case 'G': return value << 30;
+		}
+	}
+	return value;
+}
+
+// Counts the entries of a sysfs list like "0-3,8".
+static int countListEntries(std::string_view list)
+{
+	int count = 0;
+	while (!list.empty()) {
+		const std::string_view range = list.substr(0, list.find(','));
+		list.remove_prefix(std::min(range.size() + 1, list.size()));
+
+		const auto dash = range.find('-');
+		if (dash == std::string_view::npos) {
+			count++;
+		}
+		else {
+			count += int(parseSize(range.substr(dash + 1)) - parseSize(range.substr(0, dash))) + 1;
+		}
+	}
+	return count;
+}
+
+// PlatformLinux reads the topology from sysfs once on initialization. The CPU
+// count is cached as well, querying it involves a system call.
+class PlatformLinux : public Platform {
+  public:
+	PlatformLinux()
+	{
+		fmt::print("Initializing Platform for Linux\n");
+		m_cpuCount = int(std::thread::hardware_concurrency());
+		queryTopology();
+	}
+	~PlatformLinux() noexcept { fmt::print("Finalizing Platform for Linux\n"); }
+
+	int cpuCount() override
+	{
+		g_platformCpuCountCalls.add();
+		return m_cpuCount;
+	}
+
+	std::size_t cacheSize(int level) override { return level >= 1 && level <= 4 ? m_cacheSizes[level - 1] : 0; }
+	std::size_t cacheLineSize() override { return m_cacheLineSize; }
+	int numaNodeCount() override { return m_numaNodeCount; }
+
+  private:
+	void queryTopology()
+	{
+		char path[128];
+		char buffer[64];
+		char type[64];
+		for (int index = 0; index < 16; index++) {
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+			const std::size_t level = parseSize(readFile(path, buffer, sizeof(buffer)));
+			if (level == 0) {
+				break;
+			}
+
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+			if (readFile(path, type, sizeof(type)) == "Instruction" || level > 4) {
+				continue;
+			}
+
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+			m_cacheSizes[level - 1] = parseSize(readFile(path, buffer, sizeof(buffer)));
+
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", index);
+			m_cacheLineSize = parseSize(readFile(path, buffer, sizeof(buffer)));
+		}
+
+		// Not every kernel exposes the cache directories, glibc may know.
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+		const int names[] = {_SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL4_CACHE_SIZE};
+		for (int level = 0; level < 4; level++) {
+			if (m_cacheSizes[level] == 0) {
+				m_cacheSizes[level] = std::size_t(std::max(sysconf(names[level]), 0L));
+			}
+		}
+		if (m_cacheLineSize == 0) {
+			m_cacheLineSize = std::size_t(std::max(sysconf(_SC_LEVEL1_DCACHE_LINESIZE), 0L));
+		}
+#endif
+
+		m_numaNodeCount = std::max(countListEntries(readFile("/sys/devices/system/node/online", buffer, sizeof(buffer))), 1);
+	}
+
+	int m_cpuCount = 0;
+	std::size_t m_cacheSizes[4] = {};
+	std::size_t m_cacheLineSize = 0;
+	int m_numaNodeCount = 1;
+};
+
+constinit Platform* Platform::sm_impl = nullptr;
+
+static std::optional<PlatformLinux> g_platform; // <- not allocated on the heap
+
+Status Platform::initialize()
+{
+	EXAMPLE_TRACE_SCOPE("Example::Platform::initialize");
+	if (Platform::sm_impl) {
+		return EXAMPLE_STATUS(StatusCode::AlreadyInitialized, "Platform is already initialized");
+	}
+	Platform::sm_impl = &g_platform.emplace();
+	g_platformInitialized.set(1);
+	return {};
+}
+
+void Platform::finalize()
+{
+	EXAMPLE_TRACE_SCOPE("Example::Platform::finalize");
+	Platform::sm_impl = nullptr;
+	g_platform.reset();
+	g_platformInitialized.set(0);
+}
+
+} // namespace Example
+
+#endif
@@ -1,29 +1,100 @@
 #include <example/example_platform.hpp>
 
+// Linux has its own implementation, this one serves all other platforms.
+#if !defined(__linux__)
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <example/example_metrics.hpp>
+#include <example/example_trace.hpp>
+
 namespace Example {
 
+static Gauge g_platformInitialized("example_platform_initialized", "Whether the platform is currently initialized.");
+static Counter g_platformCpuCountCalls("example_platform_cpu_count_calls_total", "Number of Platform::cpuCount calls.");
+
 // PlatformWin32 is a concrete Platform implementation. It provides the member
 // functions required by the interface and implements the necessary management
 // function.
 class PlatformWin32 : public Platform {
   public:
-	PlatformWin32() { fmt::print("Initializing Platform for Win32\n"); }
+	PlatformWin32()
+	{
+		fmt::print("Initializing Platform for Win32\n");
+		queryTopology();
+	}
 	~PlatformWin32() noexcept { fmt::print("Finalizing Platform for Win32\n"); }
 
-	int cpuCount() override { return int(std::thread::hardware_concurrency()); }
+	int cpuCount() override
+	{
+		g_platformCpuCountCalls.add();
+		return int(std::thread::hardware_concurrency());
+	}
+
+	std::size_t cacheSize(int level) override { return level >= 1 && level <= 4 ? m_cacheSizes[level - 1] : 0; }
+	std::size_t cacheLineSize() override { return m_cacheLineSize; }
+	int numaNodeCount() override { return m_numaNodeCount; }
+
+  private:
+	void queryTopology()
+	{
+#if defined(_WIN32)
+		// Fixed buffer, Platform implementations must not allocate.
+		SYSTEM_LOGICAL_PROCESSOR_INFORMATION infos[256];
+		DWORD length = sizeof(infos);
+		if (!GetLogicalProcessorInformation(infos, &length)) {
+			return;
+		}
+
+		int numaNodeCount = 0;
+		for (DWORD i = 0; i < length / sizeof(infos[0]); i++) {
+			const auto& info = infos[i];
+			// Only caches of the first core are considered.
+			if (info.Relationship == RelationCache && (info.ProcessorMask & 1) && info.Cache.Type != CacheInstruction
+			    && info.Cache.Level >= 1 && info.Cache.Level <= 4) {
+				m_cacheSizes[info.Cache.Level - 1] = info.Cache.Size;
+				m_cacheLineSize = info.Cache.LineSize;
+			}
+			else if (info.Relationship == RelationNumaNode) {
+				numaNodeCount++;
+			}
+		}
+		m_numaNodeCount = std::max(numaNodeCount, 1);
+#endif
+	}
+
+	std::size_t m_cacheSizes[4] = {};
+	std::size_t m_cacheLineSize = 0;
+	int m_numaNodeCount = 1;
 };
 
+constinit Platform* Platform::sm_impl = nullptr;
+
 static std::optional<PlatformWin32> g_platform; // <- not allocated on the heap
 
-void Platform::initialize()
+Status Platform::initialize()
 {
+	EXAMPLE_TRACE_SCOPE("Example::Platform::initialize");
+	if (Platform::sm_impl) {
+		return EXAMPLE_STATUS(StatusCode::AlreadyInitialized, "Platform is already initialized");
+	}
 	Platform::sm_impl = &g_platform.emplace();
+	g_platformInitialized.set(1);
+	return {};
 }
 
 void Platform::finalize()
 {
+	EXAMPLE_TRACE_SCOPE("Example::Platform::finalize");
 	Platform::sm_impl = nullptr;
 	g_platform.reset();
+	g_platformInitialized.set(0);
 }
 
 } // namespace Example
+
+#endif
@@ -0,0 +1,305 @@
+#include <example/example_profiler.hpp>
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define EXAMPLE_HAS_PROFILER 1
+#include <csignal>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <mutex>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <unordered_map>
+#else
+#define EXAMPLE_HAS_PROFILER 0
+#endif
+
+namespace Example {
+
+#if EXAMPLE_HAS_PROFILER
+
+namespace {
+
+struct ProfileSample {
+	static constexpr unsigned MaxDepth = 64;
+
+	// Set to the sample's sequence number + 1 once all frames are stored.
+	// Depth and frames are relaxed atomics as the reader may copy them while a
+	// signal handler overwrites the slot, plain loads and stores on x86-64 and
+	// AArch64.
+	std::atomic<std::uint64_t> sequence = 0;
+	std::atomic<unsigned> depth = 0;
+	std::atomic<std::uintptr_t> frames[MaxDepth];
+};
+
+struct ProfilerThread {
+	timer_t timer;
+};
+
+} // namespace
+
+static constexpr std::size_t ProfileSampleCount = 1 << 14;
+static constexpr std::size_t MaxProfilerThreads = 256;
+
+static ProfileSample* g_profileSamples = nullptr;
+static constinit std::atomic<std::uint64_t> g_nextProfileSample = 0;
+static constinit std::atomic<bool> g_profiling = false;
+static std::chrono::microseconds g_profilingInterval;
+
+static std::mutex g_profilerThreadsMutex;
+static std::vector<ProfilerThread> g_profilerThreads;
+
+// Stack bounds of the current thread, used to validate frame pointers before
+// following them. The signal handler must not go through __tls_get_addr, which
+// may allocate when example is a shared library loaded with dlopen; the
+// initial-exec model places them in static TLS instead.
+[[gnu::tls_model("initial-exec")]] static constinit thread_local std::uintptr_t t_stackLow = 0;
+[[gnu::tls_model("initial-exec")]] static constinit thread_local std::uintptr_t t_stackHigh = 0;
+
+static void onProfileSignal(int, siginfo_t*, void* context)
+{
+	if (!g_profiling.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	const auto* machine = &static_cast<ucontext_t*>(context)->uc_mcontext;
+#if defined(__x86_64__)
+	const auto pc = std::uintptr_t(machine->gregs[REG_RIP]);
+	const auto sp = std::uintptr_t(machine->gregs[REG_RSP]);
+	auto fp = std::uintptr_t(machine->gregs[REG_RBP]);
+#else
+	const auto pc = std::uintptr_t(machine->pc);
+	const auto sp = std::uintptr_t(machine->sp);
+	auto fp = std::uintptr_t(machine->regs[29]);
+#endif
+
+	const std::uint64_t sequence = g_nextProfileSample.fetch_add(1, std::memory_order_relaxed);
+	ProfileSample& sample = g_profileSamples[sequence % ProfileSampleCount];
+	sample.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	unsigned depth = 0;
+	sample.frames[depth++].store(pc, std::memory_order_relaxed);
+
+	// Each frame starts with the caller's frame pointer followed by the return
+	// address. Frames must move towards the stack's base and stay within the
+	// part of the stack in use: the reserved range of the main thread reaches
+	// below what is actually mapped, so the interrupted stack pointer is the
+	// lower bound rather than t_stackLow.
+	std::uintptr_t low = std::max(sp, t_stackLow);
+	while (depth < ProfileSample::MaxDepth && fp % sizeof(std::uintptr_t) == 0 && fp >= low
+	       && fp + 2 * sizeof(std::uintptr_t) <= t_stackHigh) {
+		const auto* frame = reinterpret_cast<const std::uintptr_t*>(fp);
+		const std::uintptr_t next = frame[0];
+		const std::uintptr_t returnAddress = frame[1];
+		if (returnAddress == 0) {
+			break;
+		}
+		sample.frames[depth++].store(returnAddress, std::memory_order_relaxed);
+		if (next <= fp) {
+			break;
+		}
+		low = fp + 2 * sizeof(std::uintptr_t);
+		fp = next;
+	}
+
+	sample.depth.store(depth, std::memory_order_relaxed);
+	sample.sequence.store(sequence + 1, std::memory_order_release);
+}
+
+bool startProfiling(std::chrono::microseconds interval)
+{
+	if (g_profiling) {
+		return false;
+	}
+
+	if (!g_profileSamples) {
+		g_profileSamples = new ProfileSample[ProfileSampleCount];
+	}
+
+	struct sigaction action = {};
+	action.sa_sigaction = onProfileSignal;
+	action.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGPROF, &action, nullptr) != 0) {
+		return false;
+	}
+
+	g_profilingInterval = interval;
+	g_profiling = true;
+	if (!registerProfilingThread()) {
+		stopProfiling();
+		return false;
+	}
+	return true;
+}
+
+bool registerProfilingThread()
+{
+	if (!g_profiling) {
+		return false;
+	}
+
+	pthread_attr_t attributes;
+	if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+		return false;
+	}
+	void* stack;
+	std::size_t stackSize;
+	pthread_attr_getstack(&attributes, &stack, &stackSize);
+	pthread_attr_destroy(&attributes);
+	t_stackLow = std::uintptr_t(stack);
+	t_stackHigh = t_stackLow + stackSize;
+
+	// Each thread gets its own timer based on its CPU time, the signal is
+	// delivered to exactly that thread.
+	sigevent event = {};
+	event.sigev_notify = SIGEV_THREAD_ID;
+	event.sigev_signo = SIGPROF;
+#if defined(sigev_notify_thread_id)
+	event.sigev_notify_thread_id = pid_t(syscall(SYS_gettid));
+#else
+	event._sigev_un._tid = pid_t(syscall(SYS_gettid));
+#endif
+
+	ProfilerThread thread;
+	if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &thread.timer) != 0) {
+		return false;
+	}
+
+	const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(g_profilingInterval);
+	const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(g_profilingInterval - seconds);
+	itimerspec spec = {};
+	spec.it_interval.tv_sec = time_t(seconds.count());
+	spec.it_interval.tv_nsec = long(nanoseconds.count());
+	spec.it_value = spec.it_interval;
+	if (timer_settime(thread.timer, 0, &spec, nullptr) != 0) {
+		timer_delete(thread.timer);
+		return false;
+	}
+
+	std::scoped_lock lock(g_profilerThreadsMutex);
+	if (g_profilerThreads.size() == MaxProfilerThreads) {
+		timer_delete(thread.timer);
+		return false;
+	}
+	g_profilerThreads.push_back(thread);
+	return true;
+}
+
+void stopProfiling()
+{
+	std::scoped_lock lock(g_profilerThreadsMutex);
+	for (const ProfilerThread& thread : g_profilerThreads) {
+		timer_delete(thread.timer);
+	}
+	g_profilerThreads.clear();
+	g_profiling = false;
+}
+
+static std::string symbolize(std::uintptr_t address)
+{
+	// Symbols not found in the dynamic symbol table (e.g. static functions)
+	// are reported as module offset, such that they can be resolved offline.
+	Dl_info info;
+	if (dladdr(reinterpret_cast<void*>(address), &info) == 0) {
+		return fmt::format("0x{:x}", address);
+	}
+	if (!info.dli_sname) {
+		const std::string_view module = info.dli_fname ? info.dli_fname : "";
+		return fmt::format("{}+0x{:x}", module.substr(module.find_last_of('/') + 1),
+		                   address - std::uintptr_t(info.dli_fbase));
+	}
+
+	int status;
+	char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+	std::string name = status == 0 ? demangled : info.dli_sname;
+	std::free(demangled);
+
+	// Semicolons separate frames in the folded format.
+	std::replace(name.begin(), name.end(), ';', ':');
+	return name;
+}
+
+bool writeFoldedStacks(std::string_view filename)
+{
+	stopProfiling();
+	if (!g_profileSamples) {
+		return false;
+	}
+
+	std::unordered_map<std::uintptr_t, std::string> symbols;
+	std::unordered_map<std::string, std::uint64_t> stacks;
+
+	const std::uint64_t end = g_nextProfileSample.load(std::memory_order_acquire);
+	const std::uint64_t begin = end > ProfileSampleCount ? end - ProfileSampleCount : 0;
+	std::string stack;
+	std::uintptr_t frames[ProfileSample::MaxDepth];
+	for (std::uint64_t sequence = begin; sequence < end; sequence++) {
+		// Threads still handling a signal may be overwriting the slot. The
+		// frames are copied out and only used if the sequence number is the
+		// same before and after, otherwise the stack could be torn.
+		const ProfileSample& sample = g_profileSamples[sequence % ProfileSampleCount];
+		if (sample.sequence.load(std::memory_order_acquire) != sequence + 1) {
+			continue;
+		}
+		const unsigned depth = std::min(sample.depth.load(std::memory_order_relaxed), ProfileSample::MaxDepth);
+		for (unsigned i = 0; i < depth; i++) {
+			frames[i] = sample.frames[i].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sample.sequence.load(std::memory_order_relaxed) != sequence + 1) {
+			continue;
+		}
+
+		stack.clear();
+		for (unsigned i = depth; i-- > 0;) {
+			// Return addresses point behind the call instruction, which may
+			// already belong to the next function.
+			const std::uintptr_t address = i == 0 ? frames[i] : frames[i] - 1;
+			auto [symbol, inserted] = symbols.try_emplace(address);
+			if (inserted) {
+				symbol->second = symbolize(address);
+			}
+			if (!stack.empty()) {
+				stack += ';';
+			}
+			stack += symbol->second;
+		}
+		stacks[stack]++;
+	}
+
+	std::FILE* file = std::fopen(std::string(filename).c_str(), "wb");
+	if (!file) {
+		return false;
+	}
+	for (const auto& [folded, count] : stacks) {
+		fmt::print(file, "{} {}\n", folded, count);
+	}
+	return std::fclose(file) == 0;
+}
+
+#else
+
+bool startProfiling(std::chrono::microseconds)
+{
+	return false;
+}
+
+bool registerProfilingThread()
+{
+	return false;
+}
+
+void stopProfiling() {}
+
+bool writeFoldedStacks(std::string_view)
+{
+	return false;
+}
+
+#endif
+
+} // namespace Example
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// The sampling profiler periodically interrupts registered threads with
+// SIGPROF, based on the CPU time each thread consumed. The signal handler walks
+// the interrupted thread's stack using frame pointers and stores the return
+// addresses in a lock-free ring of samples. Once the ring is full, the oldest
+// samples are overwritten.
+//
+// Stacks are only complete if all code is compiled with frame pointers, see
+// the Profile build configuration. Only supported on Linux, all functions fail
+// or do nothing elsewhere.
+
+// Starts profiling and registers the calling thread.
+EXAMPLE_API bool startProfiling(std::chrono::microseconds interval);
+
+// Registers the calling thread with a running profiler. Threads must stay alive
+// until profiling is stopped.
+EXAMPLE_API bool registerProfilingThread();
+
+EXAMPLE_API void stopProfiling();
+
+// Writes the recorded samples as folded stacks (one line per unique stack,
+// root first, followed by the sample count), which is the input format of
+// flamegraph.pl and compatible tools. Stops profiling if it is still running.
+EXAMPLE_API bool writeFoldedStacks(std::string_view filename);
+
+} // namespace Example
@@ -0,0 +1,29 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_mapped_file.hpp>
+#include <example/example_profiler.hpp>
+
+using namespace Example;
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+TEST_CASE("profiler samples", "[profiler]")
+{
+	REQUIRE(startProfiling(std::chrono::microseconds(500)));
+
+	// Burn some CPU time, the profiler's timers are based on it.
+	const auto start = std::chrono::steady_clock::now();
+	volatile std::uint64_t sink = 0;
+	while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100)) {
+		sink = sink + 1;
+	}
+
+	const auto filename = "example_profiler.test.folded";
+	REQUIRE(writeFoldedStacks(filename));
+	{
+		const auto file = MappedFile::open(filename);
+		REQUIRE(file);
+		REQUIRE(!file->data().empty());
+	}
+	std::remove(filename);
+}
+#endif
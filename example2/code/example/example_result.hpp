@@ -0,0 +1,151 @@
+#pragma once
+
+#include <example/example_api.hpp>
+#include <example/example_status.hpp>
+
+// Evaluates expression, which yields a Result, and returns its Status from the
+// calling function if it is an error. Otherwise the value is moved into target,
+// which may be a declaration:
+//
+//   EXAMPLE_TRY_ASSIGN(auto file, openFile(filename));
+//
+// The value is moved exactly once, the emptied Result is left behind.
+#define EXAMPLE_TRY_ASSIGN(target, expression) \
+	EXAMPLE_TRY_ASSIGN_IMPL(target, expression, EXAMPLE_CONCAT(exampleTryResult, __COUNTER__))
+#define EXAMPLE_TRY_ASSIGN_IMPL(target, expression, result) \
+	auto&& result = (expression); \
+	if (!result.ok()) [[unlikely]] { \
+		return result.status(); \
+	} \
+	target = result.take()
+
+namespace Example {
+
+// Result holds either a value or an error Status. Values are constructed in
+// place, either from the arguments following std::in_place or by returning a
+// prvalue T, which is elided into the Result. Once the value has been taken,
+// the Result is empty and reports StatusCode::EmptyResult. The same holds for
+// a Result created from an ok status, which has no value to hold.
+//
+// A Result of a trivially copyable T is trivially copyable itself, small ones
+// are returned in registers.
+template <typename T>
+class [[nodiscard]] Result {
+  public:
+	Result(const T& value) : m_value(value) {}
+	Result(T&& value) : m_value(std::move(value)) {}
+
+	template <typename... Args>
+	explicit Result(std::in_place_t, Args&&... args) : m_value(std::forward<Args>(args)...)
+	{}
+
+	// An ok status holds no value, it results in an empty Result.
+	Result(Status error) : m_status(errorStatus(error)) {}
+	Result(StatusCode error) : m_status(errorStatus(error)) {}
+
+	Result(const Result&) requires std::is_trivially_copy_constructible_v<T> = default;
+	Result(const Result& other) : m_status(other.m_status)
+	{
+		if (m_status.ok()) {
+			std::construct_at(&m_value, other.m_value);
+		}
+	}
+
+	Result(Result&&) requires std::is_trivially_move_constructible_v<T> = default;
+	Result(Result&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : m_status(other.m_status)
+	{
+		if (m_status.ok()) {
+			std::construct_at(&m_value, std::move(other.m_value));
+		}
+	}
+
+	// Assignments destroy the current value and construct the new one, which
+	// is simpler than handling all combinations of value and error. If that
+	// throws, the Result is left empty.
+	Result& operator=(const Result&) requires std::is_trivially_copyable_v<T> = default;
+	Result& operator=(const Result& other)
+	{
+		if (this != &other) {
+			reset();
+			m_status = StatusCode::EmptyResult;
+			if (other.ok()) {
+				std::construct_at(&m_value, other.m_value);
+			}
+			m_status = other.m_status;
+		}
+		return *this;
+	}
+
+	Result& operator=(Result&&) requires std::is_trivially_copyable_v<T> = default;
+	Result& operator=(Result&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &other) {
+			reset();
+			m_status = StatusCode::EmptyResult;
+			if (other.ok()) {
+				std::construct_at(&m_value, std::move(other.m_value));
+			}
+			m_status = other.m_status;
+		}
+		return *this;
+	}
+
+	~Result() requires std::is_trivially_destructible_v<T> = default;
+	~Result() noexcept { reset(); }
+
+	bool ok() const { return m_status.ok(); }
+	Status status() const { return m_status; }
+
+	// Accessing the value requires ok().
+	T& value() & { return m_value; }
+	const T& value() const& { return m_value; }
+	T&& value() && { return std::move(m_value); }
+
+	T& operator*() & { return m_value; }
+	const T& operator*() const& { return m_value; }
+	T* operator->() { return &m_value; }
+	const T* operator->() const { return &m_value; }
+
+	// Replaces the value by the given error. Functions returning a large T can
+	// construct the Result up front and return it on every path, including
+	// errors: compilers only elide the copy of a named return value if every
+	// return statement returns it. An ok status leaves the Result empty.
+	void setError(Status error)
+	{
+		reset();
+		m_status = errorStatus(error);
+	}
+
+	// Moves the value out and destroys what is left of it, rather than keeping
+	// a moved-from value around until the Result goes away. Requires ok().
+	T take()
+	{
+		T value = std::move(m_value);
+		reset();
+		m_status = StatusCode::EmptyResult;
+		return value;
+	}
+
+  private:
+	static Status errorStatus(Status status) { return status.ok() ? Status(StatusCode::EmptyResult) : status; }
+
+	void reset()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			if (m_status.ok()) {
+				std::destroy_at(&m_value);
+			}
+		}
+	}
+
+	// Large values start on a cache line of their own: copying or filling a
+	// misaligned buffer in bulk is several times slower.
+	static constexpr std::size_t ValueAlignment = sizeof(T) >= 64 ? std::max(alignof(T), std::size_t(64)) : alignof(T);
+
+	Status m_status;
+	union alignas(ValueAlignment) {
+		T m_value;
+	};
+};
+
+} // namespace Example
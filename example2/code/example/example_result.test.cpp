@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_result.hpp>
+
+using namespace Example;
+
+static_assert(std::is_trivially_copyable_v<Result<int>>);
+static_assert(sizeof(Result<int>) == 8);
+static_assert(!std::is_trivially_copyable_v<Result<std::string>>);
+
+namespace {
+
+// Counts how often instances are copied and moved.
+struct Tracked {
+	static inline int copies = 0;
+	static inline int moves = 0;
+
+	explicit Tracked(int value) : value(value) {}
+	Tracked(const Tracked& other) : value(other.value) { copies++; }
+	Tracked(Tracked&& other) noexcept : value(other.value) { moves++; }
+	Tracked& operator=(const Tracked&) = delete;
+	Tracked& operator=(Tracked&&) = delete;
+
+	int value;
+};
+
+// Copies throw on request, live instances are counted.
+struct ThrowingCopy {
+	static inline int instances = 0;
+	static inline bool throwOnCopy = false;
+
+	ThrowingCopy() { instances++; }
+	ThrowingCopy(const ThrowingCopy&)
+	{
+		if (throwOnCopy) {
+			throw std::bad_alloc();
+		}
+		instances++;
+	}
+	~ThrowingCopy() noexcept { instances--; }
+};
+
+Result<Tracked> makeTracked(int value)
+{
+	if (value < 0) {
+		return EXAMPLE_STATUS(StatusCode::InvalidArgument, "Negative value");
+	}
+	return Result<Tracked>(std::in_place, value);
+}
+
+Result<int> doubleTracked(int value)
+{
+	EXAMPLE_TRY_ASSIGN(const Tracked tracked, makeTracked(value));
+	return tracked.value * 2;
+}
+
+} // namespace
+
+TEST_CASE("result", "[result]")
+{
+	const Result<int> value = 42;
+	REQUIRE(value.ok());
+	REQUIRE(*value == 42);
+
+	const Result<int> error = StatusCode::NotFound;
+	REQUIRE(!error.ok());
+	REQUIRE(error.status().code() == StatusCode::NotFound);
+
+	Result<std::string> text = std::string("Hello");
+	Result<std::string> copy = text;
+	REQUIRE(copy.value() == "Hello");
+	copy = Result<std::string>(StatusCode::IoError);
+	REQUIRE(copy.status().code() == StatusCode::IoError);
+	copy = text;
+	REQUIRE(copy->size() == 5);
+
+	copy.setError(StatusCode::NotFound);
+	REQUIRE(copy.status().code() == StatusCode::NotFound);
+
+	REQUIRE(text.take() == "Hello");
+	REQUIRE(text.status().code() == StatusCode::EmptyResult);
+}
+
+TEST_CASE("result from an ok status is empty", "[result]")
+{
+	const Result<std::string> fromStatus = Status{};
+	REQUIRE(!fromStatus.ok());
+	REQUIRE(fromStatus.status().code() == StatusCode::EmptyResult);
+
+	const Result<std::string> fromCode = StatusCode::Ok;
+	REQUIRE(fromCode.status().code() == StatusCode::EmptyResult);
+
+	Result<std::string> text = std::string("Hello");
+	text.setError(Status{});
+	REQUIRE(text.status().code() == StatusCode::EmptyResult);
+}
+
+TEST_CASE("result construction and unwrapping", "[result]")
+{
+	Tracked::copies = 0;
+	Tracked::moves = 0;
+
+	// Constructed in place and elided into the caller.
+	const Result<Tracked> tracked = makeTracked(21);
+	REQUIRE(tracked->value == 21);
+	REQUIRE(Tracked::copies == 0);
+	REQUIRE(Tracked::moves == 0);
+
+	// Unwrapping moves exactly once.
+	const Result<int> doubled = doubleTracked(21);
+	REQUIRE(*doubled == 42);
+	REQUIRE(Tracked::copies == 0);
+	REQUIRE(Tracked::moves == 1);
+
+	const Result<int> failed = doubleTracked(-1);
+	REQUIRE(failed.status().code() == StatusCode::InvalidArgument);
+	REQUIRE(std::string_view(failed.status().message()) == "Negative value");
+}
+
+TEST_CASE("result assignment failing to copy", "[result]")
+{
+	{
+		const Result<ThrowingCopy> source(std::in_place);
+		Result<ThrowingCopy> target(std::in_place);
+		REQUIRE(ThrowingCopy::instances == 2);
+
+		ThrowingCopy::throwOnCopy = true;
+		REQUIRE_THROWS_AS(target = source, std::bad_alloc);
+		ThrowingCopy::throwOnCopy = false;
+
+		// The old value is gone and not destroyed a second time.
+		REQUIRE(target.status().code() == StatusCode::EmptyResult);
+		REQUIRE(ThrowingCopy::instances == 1);
+	}
+	REQUIRE(ThrowingCopy::instances == 0);
+}
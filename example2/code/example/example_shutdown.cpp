@@ -0,0 +1,28 @@
+#include <example/example_shutdown.hpp>
+
+#include <csignal>
+
+namespace Example {
+
+constinit std::atomic<bool> g_shutdownRequested = false;
+
+static void onShutdownSignal(int signal)
+{
+	if (g_shutdownRequested.exchange(true)) {
+		std::_Exit(128 + signal);
+	}
+	std::signal(signal, onShutdownSignal);
+}
+
+void installShutdownHandlers()
+{
+	std::signal(SIGINT, onShutdownSignal);
+	std::signal(SIGTERM, onShutdownSignal);
+}
+
+void requestShutdown()
+{
+	g_shutdownRequested = true;
+}
+
+} // namespace Example
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+namespace Example {
+
+// Graceful shutdown is cooperative: the signal handler only records the
+// request, long-running loops poll shutdownRequested and wind down on their
+// own. A second signal terminates the process immediately, in case winding
+// down gets stuck.
+
+// Installs handlers for SIGINT and SIGTERM.
+EXAMPLE_API void installShutdownHandlers();
+
+EXAMPLE_API void requestShutdown();
+
+EXAMPLE_API extern std::atomic<bool> g_shutdownRequested;
+static_assert(std::atomic<bool>::is_always_lock_free, "required for use in signal handlers");
+
+inline bool shutdownRequested()
+{
+	return g_shutdownRequested.load(std::memory_order_relaxed);
+}
+
+} // namespace Example
@@ -0,0 +1,25 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <csignal>
+
+#include <example/example_defer.hpp>
+#include <example/example_shutdown.hpp>
+
+using namespace Example;
+
+TEST_CASE("shutdown on signal", "[shutdown]")
+{
+	// Later tests run in the same process, they get the previous handlers and
+	// a cleared flag back however this test ends.
+	const auto previousInterruptHandler = std::signal(SIGINT, SIG_DFL);
+	const auto previousTerminateHandler = std::signal(SIGTERM, SIG_DFL);
+	EXAMPLE_DEFER(std::signal(SIGINT, previousInterruptHandler));
+	EXAMPLE_DEFER(std::signal(SIGTERM, previousTerminateHandler));
+	EXAMPLE_DEFER(g_shutdownRequested = false);
+
+	installShutdownHandlers();
+	REQUIRE(!shutdownRequested());
+
+	std::raise(SIGTERM);
+	REQUIRE(shutdownRequested());
+}
@@ -0,0 +1,19 @@
+// Compiled to assembly by the example_status_codegen test, which fails if the
+// function below calls anything or has more than one conditional branch: the
+// success path of EXAMPLE_TRY is a single compare of the Status register, see
+// example_status.hpp.
+//
+// This is compiled on its own, without the precompiled header.
+
+#include <cstdint>
+#include <type_traits>
+
+#include <example/example_status.hpp>
+
+using namespace Example;
+
+Status codegenTry(Status first, Status second)
+{
+	EXAMPLE_TRY(first);
+	return second;
+}
@@ -0,0 +1,42 @@
+#include <example/example_status.hpp>
+
+namespace Example {
+
+// Messages are only ever added; a handle is handed out after its entry has been
+// stored, such that readers never see an empty entry.
+static constexpr std::size_t StatusMessageCapacity = 1024;
+static constinit std::atomic<const char*> g_statusMessages[StatusMessageCapacity] = {};
+static constinit std::atomic<std::size_t> g_statusMessageCount = 0;
+
+const char* statusCodeName(StatusCode code)
+{
+	switch (code) {
+	case StatusCode::Ok: return "ok";
+	case StatusCode::InvalidArgument: return "invalid argument";
+	case StatusCode::NotFound: return "not found";
+	case StatusCode::IoError: return "I/O error";
+	case StatusCode::OutOfMemory: return "out of memory";
+	case StatusCode::AlreadyInitialized: return "already initialized";
+	case StatusCode::Corrupted: return "corrupted";
+	case StatusCode::Unsupported: return "unsupported";
+	case StatusCode::EmptyResult: return "empty result";
+	}
+	return "unknown";
+}
+
+StatusMessage internStatusMessage(const char* text)
+{
+	const std::size_t index = g_statusMessageCount.fetch_add(1, std::memory_order_relaxed);
+	if (index >= StatusMessageCapacity) {
+		return {};
+	}
+	g_statusMessages[index].store(text, std::memory_order_release);
+	return {std::uint16_t(index + 1)};
+}
+
+const char* StatusMessage::text() const
+{
+	return handle ? g_statusMessages[handle - 1].load(std::memory_order_acquire) : "";
+}
+
+} // namespace Example
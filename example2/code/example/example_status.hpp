@@ -0,0 +1,81 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+// Returns the Status of the given expression from the calling function if it
+// is an error. The calling function must return Status as well.
+#define EXAMPLE_TRY(expression) \
+	do { \
+		if (const ::Example::Status exampleTryStatus = (expression); !exampleTryStatus.ok()) [[unlikely]] { \
+			return exampleTryStatus; \
+		} \
+	} while (false)
+
+// Creates a Status with the given code and message, which must be a string
+// literal. The message is interned on first use at this call site, later uses
+// only load its handle.
+#define EXAMPLE_STATUS(code, message) ::Example::Status(code, EXAMPLE_STATUS_MESSAGE(message))
+
+// Interns the given string literal once per call site, see EXAMPLE_STATUS.
+#define EXAMPLE_STATUS_MESSAGE(message) \
+	[] { \
+		static const ::Example::StatusMessage exampleStatusMessage = ::Example::internStatusMessage(message); \
+		return exampleStatusMessage; \
+	}()
+
+namespace Example {
+
+// Errors are reported as Status values rather than exceptions. A Status is a
+// code plus an optional message, which fits into a single register: checking
+// for success is one compare, and creating or passing on an error never
+// allocates. Messages are string literals interned into a global table, the
+// Status only holds their handle.
+
+enum class StatusCode : std::uint8_t {
+	Ok,
+	InvalidArgument,
+	NotFound,
+	IoError,
+	OutOfMemory,
+	AlreadyInitialized,
+	Corrupted,
+	Unsupported,
+	EmptyResult, // <- a Result holds no value, e.g. it has been taken
+};
+
+EXAMPLE_API const char* statusCodeName(StatusCode code);
+
+// Handle of an interned message, 0 refers to no message.
+struct StatusMessage {
+	std::uint16_t handle = 0;
+
+	// Returns the interned text, or an empty string if there is none.
+	EXAMPLE_API const char* text() const;
+};
+
+// Adds the given message to the table and returns its handle. The text must
+// outlive the program, like a string literal. Returns no message once the
+// table is full, see EXAMPLE_STATUS for interning once per call site.
+EXAMPLE_API StatusMessage internStatusMessage(const char* text);
+
+class [[nodiscard]] Status {
+  public:
+	constexpr Status() = default;
+	constexpr Status(StatusCode code, StatusMessage message = {}) : m_code(code), m_message(message.handle) {}
+
+	constexpr bool ok() const { return m_code == StatusCode::Ok; }
+	constexpr StatusCode code() const { return m_code; }
+
+	// Returns the interned message, or an empty string if there is none.
+	const char* message() const { return StatusMessage{m_message}.text(); }
+
+	friend constexpr bool operator==(Status, Status) = default;
+
+  private:
+	StatusCode m_code = StatusCode::Ok;
+	std::uint16_t m_message = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<Status> && sizeof(Status) <= sizeof(void*), "returned in a register");
+
+} // namespace Example
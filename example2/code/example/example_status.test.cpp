@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_logger_file.hpp>
+#include <example/example_status.hpp>
+
+using namespace Example;
+
+static Status failIf(bool fail)
+{
+	if (fail) {
+		return EXAMPLE_STATUS(StatusCode::InvalidArgument, "Failing as requested");
+	}
+	return {};
+}
+
+static Status propagate(bool fail, int& outReached)
+{
+	EXAMPLE_TRY(failIf(fail));
+	outReached++;
+	return {};
+}
+
+TEST_CASE("status", "[status]")
+{
+	REQUIRE(Status().ok());
+	REQUIRE(std::string_view(Status().message()).empty());
+
+	const Status status = failIf(true);
+	REQUIRE(!status.ok());
+	REQUIRE(status.code() == StatusCode::InvalidArgument);
+	REQUIRE(std::string_view(status.message()) == "Failing as requested");
+	REQUIRE(std::string_view(statusCodeName(status.code())) == "invalid argument");
+
+	// The message is interned once per call site.
+	REQUIRE(failIf(true) == status);
+
+	const Status withoutMessage = StatusCode::NotFound;
+	REQUIRE(withoutMessage.code() == StatusCode::NotFound);
+	REQUIRE(std::string_view(withoutMessage.message()).empty());
+}
+
+TEST_CASE("status propagation", "[status]")
+{
+	int reached = 0;
+	REQUIRE(propagate(false, reached).ok());
+	REQUIRE(reached == 1);
+	REQUIRE(propagate(true, reached).code() == StatusCode::InvalidArgument);
+	REQUIRE(reached == 1);
+}
+
+TEST_CASE("file logger creation failure", "[status]")
+{
+	std::unique_ptr<FileLogger> logger;
+	const Status status = FileLogger::create(logger, "example_status.test.missing/logfile.txt");
+	REQUIRE(status.code() == StatusCode::IoError);
+	REQUIRE(logger == nullptr);
+
+	REQUIRE(FileLogger::create(logger, "example_status.test.log").ok());
+	REQUIRE(logger != nullptr);
+	logger.reset();
+	std::remove("example_status.test.log");
+}
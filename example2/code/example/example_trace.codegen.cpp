@@ -0,0 +1,20 @@
+// Compiled to assembly by the example_trace_codegen test, which fails if the
+// function below has more than one conditional branch: traceCall must test
+// the flag once, see example_trace.hpp.
+//
+// This is compiled on its own, without the precompiled header.
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include <example/example_trace.hpp>
+
+using namespace Example;
+
+int work(int value) noexcept;
+
+int codegenTraceCall(int value)
+{
+	return traceCall("codegenTraceCall", [&] { return work(value); });
+}
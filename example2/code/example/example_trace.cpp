@@ -0,0 +1,167 @@
+#include <example/example_trace.hpp>
+
+#include <example/example_json.hpp>
+
+#include <mutex>
+
+namespace Example {
+
+namespace {
+
+struct TraceEvent {
+	const char* name;
+	std::uint64_t begin;
+	std::uint64_t duration;
+};
+
+// Events are stored in fixed size chunks, allocated as threads fill them.
+struct TraceChunk {
+	static constexpr std::size_t Capacity = 1024;
+
+	std::atomic<std::size_t> count = 0;
+	unsigned threadId = 0;
+	TraceChunk* next = nullptr;
+	TraceChunk* nextFree = nullptr;
+	TraceEvent events[Capacity];
+};
+
+// Holds the chunk the current thread appends to. When the thread exits, a
+// partially filled chunk is passed on to the next thread that starts tracing.
+struct TraceThread {
+	TraceChunk* chunk = nullptr;
+	~TraceThread() noexcept;
+};
+
+} // namespace
+
+constinit std::atomic<bool> g_traceEnabled = false;
+
+// Limits the memory used for tracing to 1024 chunks of 24 KiB each.
+static constexpr std::size_t MaxTraceChunks = 1024;
+
+static constinit std::atomic<TraceChunk*> g_firstTraceChunk = nullptr;
+static constinit std::atomic<std::size_t> g_traceChunkCount = 0;
+static constinit std::atomic<unsigned> g_nextTraceThreadId = 1;
+static constinit std::atomic<std::uint64_t> g_droppedTraceEvents = 0;
+
+static std::mutex g_freeTraceChunksMutex;
+static TraceChunk* g_freeTraceChunks = nullptr;
+
+// Timestamps are relative to the first one taken, this keeps the numbers in the
+// trace file short.
+static const auto g_traceOrigin = std::chrono::steady_clock::now();
+
+std::uint64_t traceTimestamp()
+{
+	const auto elapsed = std::chrono::steady_clock::now() - g_traceOrigin;
+	return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+TraceThread::~TraceThread() noexcept
+{
+	if (chunk && chunk->count.load(std::memory_order_relaxed) < TraceChunk::Capacity) {
+		std::lock_guard lock(g_freeTraceChunksMutex);
+		chunk->nextFree = g_freeTraceChunks;
+		g_freeTraceChunks = chunk;
+	}
+}
+
+// Returns the chunk following the given full one, or the first chunk of a
+// thread if full is null. A thread's first chunk is preferably one left over
+// by an exited thread, its events continue on that thread's track. Returns
+// null once the chunk limit is reached.
+static TraceChunk* nextTraceChunk(const TraceChunk* full)
+{
+	if (!full) {
+		std::lock_guard lock(g_freeTraceChunksMutex);
+		if (TraceChunk* chunk = g_freeTraceChunks) {
+			g_freeTraceChunks = chunk->nextFree;
+			return chunk;
+		}
+	}
+
+	if (g_traceChunkCount.load(std::memory_order_relaxed) >= MaxTraceChunks
+	    || g_traceChunkCount.fetch_add(1, std::memory_order_relaxed) >= MaxTraceChunks) {
+		return nullptr;
+	}
+
+	auto* chunk = new TraceChunk;
+	chunk->threadId = full ? full->threadId : g_nextTraceThreadId.fetch_add(1, std::memory_order_relaxed);
+	chunk->next = g_firstTraceChunk.load(std::memory_order_relaxed);
+	while (!g_firstTraceChunk.compare_exchange_weak(chunk->next, chunk, std::memory_order_release,
+	                                                std::memory_order_relaxed)) {}
+	return chunk;
+}
+
+void traceRecord(const char* name, std::uint64_t begin)
+{
+	const std::uint64_t end = traceTimestamp();
+
+	thread_local TraceThread thread;
+
+	TraceChunk* chunk = thread.chunk;
+	if (!chunk || chunk->count.load(std::memory_order_relaxed) == TraceChunk::Capacity) [[unlikely]] {
+		TraceChunk* next = nextTraceChunk(chunk);
+		if (!next) {
+			g_droppedTraceEvents.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		chunk = thread.chunk = next;
+	}
+
+	const std::size_t count = chunk->count.load(std::memory_order_relaxed);
+	chunk->events[count] = {name, begin, end - begin};
+	chunk->count.store(count + 1, std::memory_order_release);
+}
+
+std::uint64_t droppedTraceEvents()
+{
+	return g_droppedTraceEvents.load(std::memory_order_relaxed);
+}
+
+bool writeTraceFile(std::string_view filename)
+{
+	std::FILE* file = std::fopen(std::string(filename).c_str(), "wb");
+	if (!file) {
+		return false;
+	}
+
+	bool failed = false;
+	std::string chunk = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	bool first = true;
+
+	const auto write = [&] {
+		failed |= std::fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size();
+		chunk.clear();
+	};
+
+	for (TraceChunk* events = g_firstTraceChunk.load(std::memory_order_acquire); events; events = events->next) {
+		const std::size_t count = events->count.load(std::memory_order_acquire);
+		for (std::size_t i = 0; i < count; i++) {
+			const TraceEvent& event = events->events[i];
+			if (!first) {
+				chunk += ",\n";
+			}
+			first = false;
+
+			// Timestamps are given in microseconds.
+			chunk += "{\"name\":";
+			appendJsonString(chunk, event.name);
+			fmt::format_to(std::back_inserter(chunk), ",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{}.{:03},\"dur\":{}.{:03}}}",
+			               events->threadId, event.begin / 1000, event.begin % 1000, event.duration / 1000,
+			               event.duration % 1000);
+
+			if (chunk.size() > (1 << 16)) {
+				write();
+			}
+		}
+	}
+
+	chunk += "\n]}\n";
+	write();
+
+	failed |= std::fclose(file) != 0;
+	return !failed;
+}
+
+} // namespace Example
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <example/example_api.hpp>
+
+// Records the time spent in the current scope under the given name, which must
+// be a string literal (or otherwise outlive the trace). While tracing is
+// disabled, this tests the flag when the scope begins and its saved state when
+// the scope ends, two well predicted branches. Hot paths use traceCall, which
+// branches once.
+#define EXAMPLE_TRACE_SCOPE(name) \
+	const ::Example::TraceScope EXAMPLE_CONCAT(exampleTraceScope, __COUNTER__)(name)
+
+namespace Example {
+
+// Tracing records scopes as complete events into per-thread chunks of events.
+// Only the owning thread appends to a chunk, writeTraceFile reads all chunks
+// without locking. Chunks are never freed, events of threads that have already
+// exited are still written out. A chunk left partially filled by an exited
+// thread is reused by the next thread that starts tracing, which then shares
+// the exited thread's track. Once the memory limit for chunks is reached,
+// further events are dropped.
+
+EXAMPLE_API extern std::atomic<bool> g_traceEnabled;
+
+inline void enableTracing(bool enable)
+{
+	g_traceEnabled.store(enable, std::memory_order_relaxed);
+}
+
+EXAMPLE_API std::uint64_t traceTimestamp();
+EXAMPLE_API void traceRecord(const char* name, std::uint64_t begin);
+
+// Writes all events recorded so far in the Chrome trace event format, which
+// can be loaded by chrome://tracing and Perfetto.
+EXAMPLE_API bool writeTraceFile(std::string_view filename);
+
+// Returns the number of events dropped due to the memory limit.
+EXAMPLE_API std::uint64_t droppedTraceEvents();
+
+// Calls function, recording the time spent under the given name like
+// EXAMPLE_TRACE_SCOPE. The flag is tested once and function is inlined into
+// both paths, while tracing is disabled this costs a single, well predicted
+// branch. Returns what function returns.
+template <typename Function>
+decltype(auto) traceCall(const char* name, Function&& function)
+{
+	if (g_traceEnabled.load(std::memory_order_relaxed)) [[unlikely]] {
+		struct End {
+			~End() noexcept { traceRecord(name, begin); }
+			const char* name;
+			std::uint64_t begin;
+		};
+		const End end{name, traceTimestamp()};
+		return function();
+	}
+	return function();
+}
+
+class TraceScope {
+  public:
+	explicit TraceScope(const char* name)
+	{
+		if (g_traceEnabled.load(std::memory_order_relaxed)) [[unlikely]] {
+			m_name = name;
+			m_begin = traceTimestamp();
+		}
+	}
+
+	~TraceScope() noexcept
+	{
+		if (m_name) [[unlikely]] {
+			traceRecord(m_name, m_begin);
+		}
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+  private:
+	const char* m_name = nullptr;
+	std::uint64_t m_begin = 0;
+};
+
+} // namespace Example
@@ -0,0 +1,54 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <example/example_mapped_file.hpp>
+#include <example/example_trace.hpp>
+
+using namespace Example;
+
+TEST_CASE("trace scopes", "[trace]")
+{
+	enableTracing(true);
+	{
+		EXAMPLE_TRACE_SCOPE("example \"test\" scope");
+	}
+	std::thread([] { EXAMPLE_TRACE_SCOPE("example thread scope"); }).join();
+	REQUIRE(traceCall("example call", [] { return 42; }) == 42);
+	enableTracing(false);
+	{
+		EXAMPLE_TRACE_SCOPE("example disabled scope");
+	}
+	REQUIRE(traceCall("example disabled call", [] { return 43; }) == 43);
+
+	const auto filename = "example_trace.test.json";
+	REQUIRE(writeTraceFile(filename));
+	{
+		const auto file = MappedFile::open(filename);
+		REQUIRE(file);
+		const auto content = file->data();
+		REQUIRE(content.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+		REQUIRE(content.find("\"example \\\"test\\\" scope\",\"ph\":\"X\"") != std::string_view::npos);
+		REQUIRE(content.find("example thread scope") != std::string_view::npos);
+		REQUIRE(content.find("example call") != std::string_view::npos);
+		REQUIRE(content.find("example disabled scope") == std::string_view::npos);
+		REQUIRE(content.find("example disabled call") == std::string_view::npos);
+	}
+	std::remove(filename);
+}
+
+TEST_CASE("trace chunks are reused across threads", "[trace]")
+{
+	const auto dropped = droppedTraceEvents();
+
+	// Each thread leaves a partially filled chunk behind for the next one, more
+	// threads than the chunk limit therefore don't drop any events.
+	enableTracing(true);
+	for (int i = 0; i < 2000; i++) {
+		std::thread([] { EXAMPLE_TRACE_SCOPE("example short thread scope"); }).join();
+	}
+	for (int i = 0; i < 3000; i++) {
+		EXAMPLE_TRACE_SCOPE("example many scopes");
+	}
+	enableTracing(false);
+
+	REQUIRE(droppedTraceEvents() == dropped);
+}
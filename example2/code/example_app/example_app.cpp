@@ -1,33 +1,306 @@
 #include <fmt/core.h>
 
+#include <example/example_columnar.hpp>
+#include <example/example_error_context.hpp>
 #include <example/example_hello.hpp>
+#include <example/example_lines.hpp>
 #include <example/example_logger_file.hpp>
+#include <example/example_mapped_file.hpp>
+#include <example/example_metrics.hpp>
+#include <example/example_output.hpp>
 #include <example/example_platform.hpp>
+#include <example/example_profiler.hpp>
+#include <example/example_shutdown.hpp>
+#include <example/example_trace.hpp>
 
-int main(int argc, char* argv[])
+using namespace std::chrono_literals;
+
+struct Options {
+	std::optional<std::string_view> name; // <- may be empty, greeting without a name
+	std::string_view batchFilename;
+	std::string_view columnarFilename;
+	std::string_view metricsFilename;
+	std::string_view traceFilename;
+	std::string_view profileFilename;
+	std::chrono::milliseconds metricsInterval = 10000ms;
+	std::chrono::milliseconds drainTimeout = 2000ms;
+	bool rejectMalformed = false;
+};
+
+static bool parseOptions(Options& outOptions, int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--batch" && hasValue) {
+			outOptions.batchFilename = argv[++i];
+		}
+		else if (arg == "--columnar" && hasValue) {
+			outOptions.columnarFilename = argv[++i];
+		}
+		else if (arg == "--metrics" && hasValue) {
+			outOptions.metricsFilename = argv[++i];
+		}
+		else if (arg == "--metrics-interval" && hasValue) {
+			outOptions.metricsInterval = std::chrono::milliseconds(std::atoi(argv[++i]));
+		}
+		else if (arg == "--trace" && hasValue) {
+			outOptions.traceFilename = argv[++i];
+		}
+		else if (arg == "--profile" && hasValue) {
+			outOptions.profileFilename = argv[++i];
+		}
+		else if (arg == "--drain-timeout" && hasValue) {
+			outOptions.drainTimeout = std::chrono::milliseconds(std::atoi(argv[++i]));
+		}
+		else if (arg == "--reject-malformed") {
+			outOptions.rejectMalformed = true;
+		}
+		else if (!arg.starts_with("--") && !outOptions.name) {
+			outOptions.name = arg;
+		}
+		else {
+			return false;
+		}
+	}
+
+	// Either a single name is greeted, or a whole file.
+	if (outOptions.batchFilename.empty() == !outOptions.name) {
+		return false;
+	}
+	return outOptions.columnarFilename.empty() || !outOptions.batchFilename.empty();
+}
+
+struct BatchStats {
+	std::size_t processed = 0;
+	std::size_t malformed = 0;
+	std::size_t dropped = 0;
+	bool interrupted = false;
+	std::chrono::steady_clock::time_point shutdownTime;
+};
+
+// Greets every line of the input, emit is called with each greeting. With
+// rejectMalformed, malformed names are logged and emitted as an empty record,
+// such that records still line up with input lines; reporting them does not
+// allocate. Lines are accepted in batches, afterBatch is called after each
+// batch. Once shutdown is requested, no further batch is accepted and the
+// current one is drained until the timeout expires. Lines of the current batch
+// that were not processed by then count as dropped.
+template <typename Emit, typename AfterBatch>
+static BatchStats processInput(std::string_view input, std::chrono::milliseconds drainTimeout, bool rejectMalformed,
+                               Emit&& emit, AfterBatch&& afterBatch)
 {
-	Example::Platform::initialize();
-
-	// Set up logger
-	{
-		const auto logFilename = "logfile.txt";
-		Example::g_logger = Example::FileLogger::create(logFilename);
-		if (!Example::g_logger) {
-			fmt::print("Could not create log file: {}\n", logFilename);
+	constexpr std::size_t batchSize = 4096;
+	std::array<std::string_view, batchSize> batch;
+
+	BatchStats stats;
+	std::chrono::steady_clock::time_point deadline;
+	std::string greeting;
+
+	Example::LineScanner scanner(input);
+	while (!Example::shutdownRequested()) {
+		std::size_t count = 0;
+		{
+			EXAMPLE_TRACE_SCOPE("scan batch");
+			while (count < batchSize && scanner.next(batch[count])) {
+				count++;
+			}
+		}
+
+		EXAMPLE_TRACE_SCOPE("process batch");
+
+		for (std::size_t i = 0; i < count; i++) {
+			if (Example::shutdownRequested()) [[unlikely]] {
+				const auto now = std::chrono::steady_clock::now();
+				if (!stats.interrupted) {
+					stats.interrupted = true;
+					stats.shutdownTime = now;
+					deadline = now + drainTimeout;
+				}
+				if (now >= deadline) {
+					stats.dropped = count - i;
+					break;
+				}
+			}
+
+			greeting.clear();
+			if (const Example::Status status = rejectMalformed ? Example::validateName(batch[i]) : Example::Status();
+			    !status.ok()) [[unlikely]] {
+				Example::reportError(status, batch[i]);
+				stats.malformed++;
+			}
+			else {
+				Example::hello(greeting, batch[i]);
+			}
+			emit(greeting);
+			stats.processed++;
+		}
+
+		afterBatch();
+
+		if (count < batchSize) {
+			break;
+		}
+	}
+
+	if (Example::shutdownRequested() && !stats.interrupted) {
+		stats.interrupted = true;
+		stats.shutdownTime = std::chrono::steady_clock::now();
+	}
+
+	return stats;
+}
+
+// Greets every line of the given file. The file is mapped and lines are handed
+// to hello as views into the mapping, no per-line copies are made. Greetings
+// are either collected by the OutputWriter and written in large chunks, or
+// stored in the columnar format.
+static int runBatch(const Options& options)
+{
+	EXAMPLE_TRACE_SCOPE("runBatch");
+
+	const auto file = Example::MappedFile::open(options.batchFilename);
+	if (!file) {
+		fmt::print("Could not open input file: {}\n", options.batchFilename);
+		return 1;
+	}
+	EXAMPLE_ERROR_CONTEXT("reading batch file", options.batchFilename);
+
+	std::unique_ptr<Example::OutputWriter> textOutput;
+	std::unique_ptr<Example::ColumnarWriter> columnarOutput;
+	if (options.columnarFilename.empty()) {
+		textOutput = Example::OutputWriter::create(stdout);
+		if (!textOutput) {
+			fmt::print("Could not allocate output buffers\n");
+			return 1;
+		}
+	}
+	else {
+		columnarOutput = Example::ColumnarWriter::create(options.columnarFilename);
+		if (!columnarOutput) {
+			fmt::print("Could not create output file: {}\n", options.columnarFilename);
 			return 1;
 		}
 	}
 
-	if (argc != 2) {
-		fmt::print("usage: {} <name>\n\n", argv[0]);
+	Example::installShutdownHandlers();
+
+	auto lastMetricsWrite = std::chrono::steady_clock::now();
+
+	const BatchStats stats = processInput(
+		file->data(), options.drainTimeout, options.rejectMalformed,
+		[&](std::string& greeting) {
+			if (textOutput) {
+				greeting += '\n';
+				textOutput->write(greeting);
+			}
+			else {
+				columnarOutput->add(greeting);
+			}
+		},
+		[&] {
+			if (options.metricsFilename.empty()) {
+				return;
+			}
+			const auto now = std::chrono::steady_clock::now();
+			if (now - lastMetricsWrite >= options.metricsInterval) {
+				Example::writeMetricsFile(options.metricsFilename);
+				lastMetricsWrite = now;
+			}
+		});
+
+	// Output and log messages must be written out completely before the
+	// platform goes away.
+	int result = 0;
+	if (textOutput && !textOutput->flush()) {
+		fmt::print(stderr, "Could not write output\n");
+		result = 1;
+	}
+	if (columnarOutput && !columnarOutput->finish()) {
+		fmt::print(stderr, "Could not write output file: {}\n", options.columnarFilename);
+		result = 1;
+	}
+	if (Example::g_logger) {
+		Example::g_logger->flush();
+	}
+
+	if (stats.malformed) {
+		fmt::print(stderr, "Rejected {} malformed names, see the log file\n", stats.malformed);
+	}
+
+	if (stats.interrupted) {
+		const auto drainTime = std::chrono::steady_clock::now() - stats.shutdownTime;
+		fmt::print(stderr, "Shutdown requested: processed {} items, drained in {} ms, dropped {} items\n",
+		           stats.processed, std::chrono::duration_cast<std::chrono::milliseconds>(drainTime).count(),
+		           stats.dropped);
+		result = 1;
+	}
+
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	// Argument validation comes first, nothing else needs to be set up for
+	// printing the usage.
+	Options options;
+	if (!parseOptions(options, argc, argv)) {
+		fmt::print("usage: {} [options] <name>\n", argv[0]);
+		fmt::print("       {} [options] --batch <file>\n", argv[0]);
+		fmt::print("\n");
+		fmt::print("options:\n");
+		fmt::print("  --columnar <file>          store batch output in the columnar format\n");
+		fmt::print("  --drain-timeout <ms>       time to finish the current batch on shutdown\n");
+		fmt::print("  --metrics <file>           write metrics on exit, Prometheus format if <file> ends in .prom\n");
+		fmt::print("  --metrics-interval <ms>    also write metrics periodically during batch mode\n");
+		fmt::print("  --reject-malformed         log malformed names, emit empty records in their place\n");
+		fmt::print("  --trace <file>             write a Chrome trace event file on exit\n");
+		fmt::print("  --profile <file>           sample the process, write folded stacks on exit\n\n");
+		return 1;
+	}
+
+	Example::enableTracing(!options.traceFilename.empty());
+
+	if (!options.profileFilename.empty() && !Example::startProfiling(std::chrono::microseconds(1000))) {
+		fmt::print(stderr, "Could not start profiler\n");
+	}
+
+	if (const Example::Status status = Example::Platform::initialize(); !status.ok()) {
+		fmt::print(stderr, "Could not initialize platform: {}\n", status.message());
 		return 1;
 	}
 
-	fmt::print("{}\n", Example::hello(argv[1]));
+	// Set up logger, the log file is only created once something is logged.
+	Example::g_logger = Example::FileLogger::createLazy("logfile.txt");
 
-	fmt::print("We are running on {} CPUs.\n", Example::Platform::get().cpuCount());
+	int result = 0;
+	if (!options.batchFilename.empty()) {
+		result = runBatch(options);
+	}
+	else {
+		fmt::print("{}\n", Example::hello(*options.name));
+
+		fmt::print("We are running on {} CPUs.\n", Example::Platform::get().cpuCount());
+	}
 
 	Example::Platform::finalize();
 
-	return 0;
+	if (!options.metricsFilename.empty() && !Example::writeMetricsFile(options.metricsFilename)) {
+		fmt::print(stderr, "Could not write metrics file: {}\n", options.metricsFilename);
+	}
+
+	if (!options.profileFilename.empty() && !Example::writeFoldedStacks(options.profileFilename)) {
+		fmt::print(stderr, "Could not write profile: {}\n", options.profileFilename);
+	}
+
+	if (!options.traceFilename.empty()) {
+		if (!Example::writeTraceFile(options.traceFilename)) {
+			fmt::print(stderr, "Could not write trace file: {}\n", options.traceFilename);
+		}
+		if (const auto dropped = Example::droppedTraceEvents()) {
+			fmt::print(stderr, "Trace memory limit reached, dropped {} events\n", dropped);
+		}
+	}
+
+	return result;
 }
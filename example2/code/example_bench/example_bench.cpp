@@ -0,0 +1,727 @@
+#include <example_bench/example_bench.hpp>
+
+#include <ctime>
+
+#include <example/example_isa.hpp>
+#include <example/example_json.hpp>
+#include <example/example_mapped_file.hpp>
+#include <example/example_platform.hpp>
+#include <example_bench/example_bench_json.hpp>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+// example_bench runs all registered benchmarks with a fixed policy: each
+// benchmark is calibrated such that a sample takes at least the minimum sample
+// time, warmed up, and then measured for the given number of samples. Threaded
+// benchmarks are measured for each thread count, their scaling efficiency is
+// the throughput per thread relative to a single thread. Results are printed
+// as a table and can be written as JSON, including information about the
+// environment they were recorded in.
+//
+// Latency benchmarks are run open-loop at a fixed rate for a fixed duration and
+// report percentiles corrected for coordinated omission. They are not part of
+// the comparison, their percentiles are too noisy for a meaningful test.
+//
+// Two result files can be compared with --compare, which flags statistically
+// significant changes using the Mann-Whitney U test on the samples.
+
+#ifndef EXAMPLE_BUILD_TYPE
+#define EXAMPLE_BUILD_TYPE "unknown"
+#endif
+
+using namespace std::chrono_literals;
+
+namespace Example::Bench {
+
+static const Benchmark* g_firstBenchmark = nullptr;
+static Benchmark* g_lastBenchmark = nullptr;
+
+// Benchmarks are kept in registration order, registration happens during
+// static initialization only.
+Benchmark::Benchmark(const char* name, void (*function)(State&), bool threaded)
+    : m_name(name), m_function(function), m_threaded(threaded), m_next(nullptr)
+{
+	if (g_lastBenchmark) {
+		g_lastBenchmark->m_next = this;
+	}
+	else {
+		g_firstBenchmark = this;
+	}
+	g_lastBenchmark = this;
+}
+
+const Benchmark* Benchmark::first()
+{
+	return g_firstBenchmark;
+}
+
+static const LatencyBenchmark* g_firstLatencyBenchmark = nullptr;
+static LatencyBenchmark* g_lastLatencyBenchmark = nullptr;
+
+LatencyBenchmark::LatencyBenchmark(const char* name, void (*function)(LatencyState&))
+    : m_name(name), m_function(function), m_next(nullptr)
+{
+	if (g_lastLatencyBenchmark) {
+		g_lastLatencyBenchmark->m_next = this;
+	}
+	else {
+		g_firstLatencyBenchmark = this;
+	}
+	g_lastLatencyBenchmark = this;
+}
+
+const LatencyBenchmark* LatencyBenchmark::first()
+{
+	return g_firstLatencyBenchmark;
+}
+
+bool LatencyState::keepRunning()
+{
+	auto now = std::chrono::steady_clock::now();
+	if (m_issued == 0) {
+		m_start = now;
+	}
+	else {
+		m_corrected.record(std::uint64_t((now - m_scheduled).count()));
+		m_uncorrected.record(std::uint64_t((now - m_actual).count()));
+	}
+
+	if (m_issued == m_iterations) {
+		return false;
+	}
+
+	// Iterations that are behind schedule start immediately.
+	m_scheduled = m_start + m_interval * std::int64_t(m_issued);
+	while (now < m_scheduled) {
+		now = std::chrono::steady_clock::now();
+	}
+	m_actual = now;
+	m_issued++;
+	return true;
+}
+
+} // namespace Example::Bench
+
+using namespace Example::Bench;
+
+namespace {
+
+struct Options {
+	std::string_view filter;
+	std::string_view outputFilename;
+	std::chrono::milliseconds warmup = 200ms;
+	std::chrono::milliseconds minSampleTime = 10ms;
+	int samples = 30;
+	int cpu = 0;
+	int maxThreads = int(std::thread::hardware_concurrency());
+	int rate = 100000; // <- latency benchmark iterations per second
+	std::chrono::milliseconds duration = 2000ms;
+
+	std::string_view baselineFilename;
+	std::string_view candidateFilename;
+	double threshold = 0.05;
+	double alpha = 0.01;
+};
+
+struct Summary {
+	double min = 0.0;
+	double median = 0.0;
+	double mean = 0.0;
+	double stddev = 0.0;
+	double max = 0.0;
+};
+
+struct Result {
+	std::string name;
+	int threads = 1;
+	double scalingEfficiency = 1.0; // <- per-thread throughput relative to 1 thread
+	std::uint64_t iterations = 0;
+	std::uint64_t itemsPerIteration = 1;
+	double allocationsPerIteration = 0.0;
+	double bytesPerIteration = 0.0;
+	std::vector<double> samples; // <- nanoseconds per iteration
+	Summary summary;
+};
+
+struct LatencyResult {
+	std::string name;
+	Example::HistogramSnapshot corrected;
+	Example::HistogramSnapshot uncorrected;
+};
+
+Summary summarize(std::vector<double> values)
+{
+	Summary summary;
+	if (values.empty()) {
+		return summary;
+	}
+
+	std::sort(values.begin(), values.end());
+	const std::size_t n = values.size();
+	summary.min = values.front();
+	summary.max = values.back();
+	summary.median = n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+	for (double value : values) {
+		summary.mean += value;
+	}
+	summary.mean /= double(n);
+	for (double value : values) {
+		summary.stddev += (value - summary.mean) * (value - summary.mean);
+	}
+	summary.stddev = n > 1 ? std::sqrt(summary.stddev / double(n - 1)) : 0.0;
+	return summary;
+}
+
+bool pinToCpu(int cpu)
+{
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(std::size_t(cpu), &set);
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	(void)cpu;
+	return false;
+#endif
+}
+
+std::string readFirstLine(const char* filename, std::string_view prefix = {})
+{
+	std::FILE* file = std::fopen(filename, "r");
+	if (!file) {
+		return {};
+	}
+	std::string result;
+	char line[512];
+	while (std::fgets(line, sizeof(line), file)) {
+		std::string_view view = line;
+		if (view.starts_with(prefix)) {
+			view.remove_prefix(prefix.size());
+			view.remove_prefix(std::min(view.find_first_not_of(" \t:"), view.size()));
+			while (!view.empty() && (view.back() == '\n' || view.back() == ' ')) {
+				view.remove_suffix(1);
+			}
+			result = view;
+			break;
+		}
+	}
+	std::fclose(file);
+	return result;
+}
+
+void appendEnvironment(std::string& out, const Options& options, bool pinned)
+{
+	auto inserter = std::back_inserter(out);
+
+	char date[32];
+	const std::time_t now = std::time(nullptr);
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+	std::string host = "unknown";
+	std::string os = "unknown";
+#if defined(__linux__)
+	utsname name;
+	if (uname(&name) == 0) {
+		host = name.nodename;
+		os = fmt::format("{} {} {}", name.sysname, name.release, name.machine);
+	}
+#elif defined(_WIN32)
+	os = "Windows";
+#endif
+
+#if defined(__clang__)
+	const std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+	const std::string compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+	const std::string compiler = fmt::format("msvc {}", _MSC_FULL_VER);
+#else
+	const std::string compiler = "unknown";
+#endif
+
+	out += "\"environment\": {\n";
+	out += "    \"date\": ";
+	Example::appendJsonString(out, date);
+	out += ",\n    \"host\": ";
+	Example::appendJsonString(out, host);
+	out += ",\n    \"os\": ";
+	Example::appendJsonString(out, os);
+	out += ",\n    \"cpu\": ";
+	Example::appendJsonString(out, readFirstLine("/proc/cpuinfo", "model name"));
+	fmt::format_to(inserter, ",\n    \"cpuCount\": {}", std::thread::hardware_concurrency());
+	out += ",\n    \"cpuGovernor\": ";
+	Example::appendJsonString(out, readFirstLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor"));
+	fmt::format_to(inserter, ",\n    \"pinnedCpu\": {}", pinned ? options.cpu : -1);
+	out += ",\n    \"compiler\": ";
+	Example::appendJsonString(out, compiler);
+	out += ",\n    \"buildType\": ";
+	Example::appendJsonString(out, EXAMPLE_BUILD_TYPE);
+	out += ",\n    \"isaLevel\": ";
+	Example::appendJsonString(out, Example::isaLevelName(Example::isaLevel()));
+	out += "\n  },\n";
+
+	fmt::format_to(inserter,
+	               "  \"policy\": {{\"warmupMs\": {}, \"minSampleTimeMs\": {}, \"samples\": {}, \"maxThreads\": {}, "
+	               "\"latencyRate\": {}, \"latencyDurationMs\": {}}},\n",
+	               options.warmup.count(), options.minSampleTime.count(), options.samples, options.maxThreads,
+	               options.rate, options.duration.count());
+}
+
+void appendLatencyJson(std::string& out, const Example::HistogramSnapshot& latency)
+{
+	fmt::format_to(std::back_inserter(out),
+	               "{{\"count\": {}, \"mean\": {:.1f}, \"p50\": {}, \"p90\": {}, \"p99\": {}, \"p999\": {}, "
+	               "\"max\": {}}}",
+	               latency.count, latency.mean(), latency.percentile(50.0), latency.percentile(90.0),
+	               latency.percentile(99.0), latency.percentile(99.9), latency.max);
+}
+
+std::string toJson(const std::vector<Result>& results, const std::vector<LatencyResult>& latencyResults,
+                   const Options& options, bool pinned)
+{
+	std::string out = "{\n  ";
+	appendEnvironment(out, options, pinned);
+	out += "  \"benchmarks\": [";
+
+	auto inserter = std::back_inserter(out);
+	for (std::size_t i = 0; i < results.size(); i++) {
+		const Result& result = results[i];
+		out += i ? ",\n    {\"name\": " : "\n    {\"name\": ";
+		Example::appendJsonString(out, result.name);
+		fmt::format_to(inserter,
+		               ", \"unit\": \"ns\", \"threads\": {}, \"scalingEfficiency\": {:.3f}, \"iterations\": {}, "
+		               "\"itemsPerIteration\": {}, "
+		               "\"allocationsPerIteration\": {:.3f}, \"bytesPerIteration\": {:.3f}, \"min\": {:.3f}, "
+		               "\"median\": {:.3f}, \"mean\": {:.3f}, \"stddev\": {:.3f}, \"max\": {:.3f}, \"samples\": [",
+		               result.threads, result.scalingEfficiency, result.iterations, result.itemsPerIteration,
+		               result.allocationsPerIteration, result.bytesPerIteration, result.summary.min,
+		               result.summary.median, result.summary.mean, result.summary.stddev, result.summary.max);
+		for (std::size_t j = 0; j < result.samples.size(); j++) {
+			fmt::format_to(inserter, "{}{:.3f}", j ? ", " : "", result.samples[j]);
+		}
+		out += "]}";
+	}
+	out += "\n  ],\n";
+
+	// Latencies are in nanoseconds.
+	out += "  \"latency\": [";
+	for (std::size_t i = 0; i < latencyResults.size(); i++) {
+		const LatencyResult& result = latencyResults[i];
+		out += i ? ",\n    {\"name\": " : "\n    {\"name\": ";
+		Example::appendJsonString(out, result.name);
+		out += ", \"corrected\": ";
+		appendLatencyJson(out, result.corrected);
+		out += ", \"uncorrected\": ";
+		appendLatencyJson(out, result.uncorrected);
+		out += "}";
+	}
+	out += "\n  ]\n}\n";
+	return out;
+}
+
+struct Sample {
+	std::chrono::nanoseconds elapsed{};
+	std::uint64_t itemsPerIteration = 1;
+	Example::AllocationStats allocations;
+};
+
+// Runs one sample. With more than one thread, each thread runs the given number
+// of iterations and the slowest thread determines the elapsed time. Threads are
+// pinned to consecutive CPUs if pinning is enabled.
+Sample runSample(const Benchmark& benchmark, std::uint64_t iterations, int threads, bool pinned, const Options& options)
+{
+	if (threads == 1) {
+		State state(iterations);
+		benchmark.run(state);
+		return {state.elapsed(), state.itemsPerIteration(), state.allocations()};
+	}
+
+	std::atomic<int> startLine = threads;
+	std::vector<State> states;
+	states.reserve(std::size_t(threads));
+	for (int i = 0; i < threads; i++) {
+		states.emplace_back(iterations, i, threads, &startLine);
+	}
+
+	std::vector<std::thread> workers;
+	for (int i = 0; i < threads; i++) {
+		workers.emplace_back([&, i] {
+			if (pinned) {
+				pinToCpu((options.cpu + i) % std::max(int(std::thread::hardware_concurrency()), 1));
+			}
+			benchmark.run(states[std::size_t(i)]);
+		});
+	}
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	Sample sample;
+	for (const State& state : states) {
+		sample.elapsed = std::max(sample.elapsed, state.elapsed());
+		sample.itemsPerIteration = state.itemsPerIteration();
+		sample.allocations.allocations += state.allocations().allocations;
+		sample.allocations.bytes += state.allocations().bytes;
+	}
+	return sample;
+}
+
+Result runBenchmark(const Benchmark& benchmark, int threads, bool pinned, const Options& options)
+{
+	Result result;
+	result.name = threads == 1 && !benchmark.threaded() ? benchmark.name()
+	                                                    : fmt::format("{}/threads:{}", benchmark.name(), threads);
+	result.threads = threads;
+
+	// Calibrate iterations per sample.
+	std::uint64_t iterations = 1;
+	while (true) {
+		const Sample sample = runSample(benchmark, iterations, threads, pinned, options);
+		if (sample.elapsed >= options.minSampleTime || iterations >= (std::uint64_t(1) << 40)) {
+			break;
+		}
+		iterations *= 2;
+	}
+	result.iterations = iterations;
+
+	const auto warmupEnd = std::chrono::steady_clock::now() + options.warmup;
+	while (std::chrono::steady_clock::now() < warmupEnd) {
+		runSample(benchmark, iterations, threads, pinned, options);
+	}
+
+	Example::AllocationStats allocations;
+	for (int i = 0; i < options.samples; i++) {
+		const Sample sample = runSample(benchmark, iterations, threads, pinned, options);
+		result.itemsPerIteration = sample.itemsPerIteration;
+		result.samples.push_back(double(sample.elapsed.count()) / double(iterations));
+
+		allocations.allocations += sample.allocations.allocations;
+		allocations.bytes += sample.allocations.bytes;
+	}
+
+	// Allocations are reported per iteration and thread.
+	const double totalIterations = double(iterations) * double(options.samples) * double(threads);
+	result.allocationsPerIteration = double(allocations.allocations) / totalIterations;
+	result.bytesPerIteration = double(allocations.bytes) / totalIterations;
+
+	result.summary = summarize(result.samples);
+	return result;
+}
+
+LatencyResult runLatencyBenchmark(const LatencyBenchmark& benchmark, const Options& options)
+{
+	const std::chrono::nanoseconds interval = 1000000000ns / std::max(options.rate, 1);
+
+	LatencyState warmup(std::uint64_t(options.warmup / interval), interval);
+	benchmark.run(warmup);
+
+	LatencyState state(std::max<std::uint64_t>(std::uint64_t(options.duration / interval), 1), interval);
+	benchmark.run(state);
+	return {benchmark.name(), state.corrected(), state.uncorrected()};
+}
+
+std::string formatDuration(double nanoseconds)
+{
+	if (nanoseconds < 1e3) {
+		return fmt::format("{:.2f} ns", nanoseconds);
+	}
+	if (nanoseconds < 1e6) {
+		return fmt::format("{:.2f} us", nanoseconds / 1e3);
+	}
+	return fmt::format("{:.2f} ms", nanoseconds / 1e6);
+}
+
+int runBenchmarks(const Options& options)
+{
+	bool pinned = false;
+	if (options.cpu >= 0) {
+		pinned = pinToCpu(options.cpu);
+		if (!pinned) {
+			fmt::print(stderr, "Could not pin to CPU {}, running unpinned\n", options.cpu);
+		}
+	}
+
+	// Threaded benchmarks run on 1, 2, 4, ... threads, and on maxThreads.
+	std::vector<int> threadCounts;
+	for (int threads = 1; threads < options.maxThreads; threads *= 2) {
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(std::max(options.maxThreads, 1));
+
+	// Platform queries are benchmarked too.
+	if (const Example::Status status = Example::Platform::initialize(); !status.ok()) {
+		fmt::print(stderr, "Could not initialize platform: {}\n", status.message());
+		return 1;
+	}
+
+	fmt::print("{:<40} {:>12} {:>10} {:>14} {:>10} {:>10} {:>9}\n", "benchmark", "median", "stddev", "items/s",
+	           "allocs/it", "bytes/it", "scaling");
+
+	std::vector<Result> results;
+	for (const Benchmark* benchmark = Benchmark::first(); benchmark; benchmark = benchmark->next()) {
+		if (std::string_view(benchmark->name()).find(options.filter) == std::string_view::npos) {
+			continue;
+		}
+
+		double singleThreadMedian = 0.0;
+		for (int threads : benchmark->threaded() ? threadCounts : std::vector<int>{1}) {
+			results.push_back(runBenchmark(*benchmark, threads, pinned, options));
+
+			// Each thread runs the same number of iterations, with perfect
+			// scaling the time per iteration stays the same.
+			Result& result = results.back();
+			if (threads == 1) {
+				singleThreadMedian = result.summary.median;
+			}
+			result.scalingEfficiency = singleThreadMedian / std::max(result.summary.median, 1e-9);
+
+			// Throughput is reported across all threads.
+			const double stddevPercent = 100.0 * result.summary.stddev / std::max(result.summary.mean, 1e-9);
+			const double itemsPerSecond = double(result.itemsPerIteration) * double(threads) * 1e9
+			                            / std::max(result.summary.median, 1e-9);
+			fmt::print("{:<40} {:>12} {:>9.1f}% {:>14.4g} {:>10.2f} {:>10.1f} {:>9}\n", result.name,
+			           formatDuration(result.summary.median), stddevPercent, itemsPerSecond,
+			           result.allocationsPerIteration, result.bytesPerIteration,
+			           benchmark->threaded() ? fmt::format("{:.0f}%", 100.0 * result.scalingEfficiency) : "");
+		}
+	}
+
+	// Latency benchmarks run open-loop at the given rate, the uncorrected p99
+	// is shown to point out the effect of coordinated omission.
+	std::vector<LatencyResult> latencyResults;
+	for (const LatencyBenchmark* benchmark = LatencyBenchmark::first(); benchmark; benchmark = benchmark->next()) {
+		if (std::string_view(benchmark->name()).find(options.filter) == std::string_view::npos) {
+			continue;
+		}
+		if (latencyResults.empty()) {
+			fmt::print("\n{:<40} {:>12} {:>12} {:>12} {:>12} {:>12}\n", fmt::format("latency at {}/s", options.rate),
+			           "p50", "p99", "p99.9", "max", "p99 uncorr.");
+		}
+		latencyResults.push_back(runLatencyBenchmark(*benchmark, options));
+
+		const LatencyResult& result = latencyResults.back();
+		fmt::print("{:<40} {:>12} {:>12} {:>12} {:>12} {:>12}\n", result.name,
+		           formatDuration(double(result.corrected.percentile(50.0))),
+		           formatDuration(double(result.corrected.percentile(99.0))),
+		           formatDuration(double(result.corrected.percentile(99.9))),
+		           formatDuration(double(result.corrected.max)),
+		           formatDuration(double(result.uncorrected.percentile(99.0))));
+	}
+
+	Example::Platform::finalize();
+
+	if (!options.outputFilename.empty()) {
+		const std::string json = toJson(results, latencyResults, options, pinned);
+		std::FILE* file = std::fopen(std::string(options.outputFilename).c_str(), "wb");
+		if (!file) {
+			fmt::print(stderr, "Could not create output file: {}\n", options.outputFilename);
+			return 1;
+		}
+		const bool failed = std::fwrite(json.data(), 1, json.size(), file) != json.size();
+		if ((std::fclose(file) != 0) | failed) {
+			fmt::print(stderr, "Could not write output file: {}\n", options.outputFilename);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+// Two-sided Mann-Whitney U test using the normal approximation with tie and
+// continuity correction. Returns the p-value for the hypothesis that both
+// samples come from the same distribution.
+double mannWhitneyU(const std::vector<double>& a, const std::vector<double>& b)
+{
+	const std::size_t n1 = a.size();
+	const std::size_t n2 = b.size();
+	if (n1 == 0 || n2 == 0) {
+		return 1.0;
+	}
+
+	std::vector<std::pair<double, bool>> values; // <- value, is from a
+	for (double value : a) {
+		values.emplace_back(value, true);
+	}
+	for (double value : b) {
+		values.emplace_back(value, false);
+	}
+	std::sort(values.begin(), values.end());
+
+	// Ranks start at 1, tied values get the average of their ranks.
+	double rankSumA = 0.0;
+	double tieCorrection = 0.0;
+	for (std::size_t i = 0; i < values.size();) {
+		std::size_t j = i;
+		while (j < values.size() && values[j].first == values[i].first) {
+			j++;
+		}
+		const double rank = double(i + j + 1) / 2.0;
+		for (std::size_t k = i; k < j; k++) {
+			rankSumA += values[k].second ? rank : 0.0;
+		}
+		const double ties = double(j - i);
+		tieCorrection += ties * ties * ties - ties;
+		i = j;
+	}
+
+	const double n = double(n1 + n2);
+	const double u = rankSumA - double(n1 * (n1 + 1)) / 2.0;
+	const double mean = double(n1 * n2) / 2.0;
+	const double variance = double(n1 * n2) / 12.0 * ((n + 1.0) - tieCorrection / (n * (n - 1.0)));
+	if (variance <= 0.0) {
+		return 1.0;
+	}
+	const double z = std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+	return std::erfc(z / std::sqrt(2.0));
+}
+
+bool loadResults(JsonValue& outResults, std::string_view filename)
+{
+	const auto file = Example::MappedFile::open(filename);
+	if (!file) {
+		fmt::print(stderr, "Could not open result file: {}\n", filename);
+		return false;
+	}
+	if (!parseJson(outResults, file->data()) || !outResults.find("benchmarks")) {
+		fmt::print(stderr, "Could not parse result file: {}\n", filename);
+		return false;
+	}
+	return true;
+}
+
+std::vector<double> samplesOf(const JsonValue& benchmark)
+{
+	std::vector<double> samples;
+	if (const JsonValue* values = benchmark.find("samples")) {
+		for (const JsonValue& value : values->array) {
+			samples.push_back(value.number);
+		}
+	}
+	return samples;
+}
+
+// Returns 1 if any benchmark regressed, such that this can be used in scripts.
+int compareResults(const Options& options)
+{
+	JsonValue baseline;
+	JsonValue candidate;
+	if (!loadResults(baseline, options.baselineFilename) || !loadResults(candidate, options.candidateFilename)) {
+		return 2;
+	}
+
+	for (const JsonValue* results : {&baseline, &candidate}) {
+		if (const JsonValue* environment = results->find("environment")) {
+			fmt::print("{}: {} on {}, {}\n", results == &baseline ? "baseline " : "candidate",
+			           environment->stringOr("buildType", "?"), environment->stringOr("cpu", "?"),
+			           environment->stringOr("date", "?"));
+		}
+	}
+	fmt::print("\n{:<40} {:>12} {:>12} {:>9} {:>9}  verdict\n", "benchmark", "baseline", "candidate", "change",
+	           "p-value");
+
+	bool regressed = false;
+	for (const JsonValue& newBenchmark : candidate.find("benchmarks")->array) {
+		const std::string_view name = newBenchmark.stringOr("name", "");
+		const JsonValue* oldBenchmark = nullptr;
+		for (const JsonValue& benchmark : baseline.find("benchmarks")->array) {
+			if (benchmark.stringOr("name", "") == name) {
+				oldBenchmark = &benchmark;
+			}
+		}
+		if (!oldBenchmark) {
+			fmt::print("{:<40} {:>12} {:>12}\n", name, "-", "new");
+			continue;
+		}
+
+		const auto oldSamples = samplesOf(*oldBenchmark);
+		const auto newSamples = samplesOf(newBenchmark);
+		const double oldMedian = summarize(oldSamples).median;
+		const double newMedian = summarize(newSamples).median;
+		const double change = oldMedian > 0.0 ? (newMedian - oldMedian) / oldMedian : 0.0;
+		const double p = mannWhitneyU(oldSamples, newSamples);
+
+		std::string_view verdict = "";
+		if (p < options.alpha && std::abs(change) > options.threshold) {
+			verdict = change > 0.0 ? "REGRESSION" : "improvement";
+			regressed |= change > 0.0;
+		}
+		fmt::print("{:<40} {:>12} {:>12} {:>+8.1f}% {:>9.2g}  {}\n", name, formatDuration(oldMedian),
+		           formatDuration(newMedian), 100.0 * change, p, verdict);
+	}
+
+	return regressed ? 1 : 0;
+}
+
+bool parseOptions(Options& outOptions, int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--filter" && hasValue) {
+			outOptions.filter = argv[++i];
+		}
+		else if (arg == "--output" && hasValue) {
+			outOptions.outputFilename = argv[++i];
+		}
+		else if (arg == "--warmup" && hasValue) {
+			outOptions.warmup = std::chrono::milliseconds(std::atoi(argv[++i]));
+		}
+		else if (arg == "--min-sample-time" && hasValue) {
+			outOptions.minSampleTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+		}
+		else if (arg == "--samples" && hasValue) {
+			outOptions.samples = std::max(std::atoi(argv[++i]), 1);
+		}
+		else if (arg == "--cpu" && hasValue) {
+			outOptions.cpu = std::atoi(argv[++i]);
+		}
+		else if (arg == "--max-threads" && hasValue) {
+			outOptions.maxThreads = std::max(std::atoi(argv[++i]), 1);
+		}
+		else if (arg == "--rate" && hasValue) {
+			outOptions.rate = std::max(std::atoi(argv[++i]), 1);
+		}
+		else if (arg == "--duration" && hasValue) {
+			outOptions.duration = std::chrono::milliseconds(std::atoi(argv[++i]));
+		}
+		else if (arg == "--compare" && i + 2 < argc) {
+			outOptions.baselineFilename = argv[++i];
+			outOptions.candidateFilename = argv[++i];
+		}
+		else if (arg == "--threshold" && hasValue) {
+			outOptions.threshold = std::atof(argv[++i]) / 100.0;
+		}
+		else if (arg == "--alpha" && hasValue) {
+			outOptions.alpha = std::atof(argv[++i]);
+		}
+		else {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions(options, argc, argv)) {
+		fmt::print("usage: {} [--filter <text>] [--output <file.json>] [--cpu <index>|-1]\n", argv[0]);
+		fmt::print("       {:{}} [--warmup <ms>] [--min-sample-time <ms>] [--samples <count>] [--max-threads <count>]\n",
+		           "", std::string_view(argv[0]).size());
+		fmt::print("       {:{}} [--rate <per second>] [--duration <ms>]\n", "", std::string_view(argv[0]).size());
+		fmt::print("       {} --compare <baseline.json> <candidate.json> [--threshold <percent>] [--alpha <p>]\n\n",
+		           argv[0]);
+		return 1;
+	}
+
+	if (!options.baselineFilename.empty()) {
+		return compareResults(options);
+	}
+	return runBenchmarks(options);
+}
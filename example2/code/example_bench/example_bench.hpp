@@ -0,0 +1,191 @@
+#pragma once
+
+#include <example/example_allocations.hpp>
+#include <example/example_api.hpp>
+#include <example/example_metrics.hpp>
+
+// Defines and registers a benchmark. The body receives `state` and runs the
+// measured code while state.keepRunning() returns true:
+//
+//   EXAMPLE_BENCHMARK("hello with name")
+//   {
+//       while (state.keepRunning()) {
+//           doNotOptimize(hello("Tim"));
+//       }
+//   }
+#define EXAMPLE_BENCHMARK(name) \
+	EXAMPLE_BENCHMARK_IMPL(name, false, EXAMPLE_CONCAT(exampleBenchmark, __COUNTER__))
+
+// Defines and registers a benchmark that is run concurrently by 1, 2, 4, ...
+// threads up to the number of CPUs. Every thread runs the body with its own
+// state, iterations start at the same time on all threads.
+#define EXAMPLE_BENCHMARK_THREADED(name) \
+	EXAMPLE_BENCHMARK_IMPL(name, true, EXAMPLE_CONCAT(exampleBenchmark, __COUNTER__))
+
+#define EXAMPLE_BENCHMARK_IMPL(name, threaded, function) \
+	static void function(::Example::Bench::State& state); \
+	static const ::Example::Bench::Benchmark EXAMPLE_CONCAT(function, Registration)(name, function, threaded); \
+	static void function([[maybe_unused]] ::Example::Bench::State& state)
+
+// Defines and registers a latency benchmark. The body looks the same as for
+// EXAMPLE_BENCHMARK, but receives a LatencyState which paces the iterations.
+#define EXAMPLE_LATENCY_BENCHMARK(name) \
+	EXAMPLE_LATENCY_BENCHMARK_IMPL(name, EXAMPLE_CONCAT(exampleLatencyBenchmark, __COUNTER__))
+#define EXAMPLE_LATENCY_BENCHMARK_IMPL(name, function) \
+	static void function(::Example::Bench::LatencyState& state); \
+	static const ::Example::Bench::LatencyBenchmark EXAMPLE_CONCAT(function, Registration)(name, function); \
+	static void function([[maybe_unused]] ::Example::Bench::LatencyState& state)
+
+namespace Example::Bench {
+
+// Prevents the compiler from optimizing away the computation of value.
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+// State drives a single sample of a benchmark: keepRunning returns true for the
+// requested number of iterations. The time and the allocations between the
+// first and the last call are measured.
+class State {
+  public:
+	explicit State(std::uint64_t iterations) : m_iterations(iterations) {}
+
+	// For threaded benchmarks, startLine is shared by all threads and
+	// initialized to threadCount.
+	State(std::uint64_t iterations, int threadIndex, int threadCount, std::atomic<int>* startLine)
+	    : m_iterations(iterations), m_threadIndex(threadIndex), m_threadCount(threadCount), m_startLine(startLine)
+	{}
+
+	bool keepRunning()
+	{
+		if (m_remaining != 0) [[likely]] {
+			m_remaining--;
+			return true;
+		}
+		return startOrStop();
+	}
+
+	// Benchmarks may process more than one item per iteration, this is used
+	// for reporting throughput.
+	void setItemsPerIteration(std::uint64_t items) { m_itemsPerIteration = items; }
+
+	int threadIndex() const { return m_threadIndex; }
+	int threadCount() const { return m_threadCount; }
+
+	std::uint64_t iterations() const { return m_iterations; }
+	std::uint64_t itemsPerIteration() const { return m_itemsPerIteration; }
+	std::chrono::nanoseconds elapsed() const { return m_stop - m_start; }
+	AllocationStats allocations() const { return m_allocations; }
+
+  private:
+	bool startOrStop()
+	{
+		if (!m_started) {
+			m_started = true;
+			if (m_startLine) {
+				m_startLine->fetch_sub(1);
+				while (m_startLine->load() > 0) {
+					std::this_thread::yield();
+				}
+			}
+			m_remaining = m_iterations - 1;
+			m_allocations = threadAllocations();
+			m_start = std::chrono::steady_clock::now();
+			return m_iterations != 0;
+		}
+		m_stop = std::chrono::steady_clock::now();
+		m_allocations = threadAllocations() - m_allocations;
+		return false;
+	}
+
+	std::uint64_t m_iterations;
+	std::uint64_t m_remaining = 0;
+	std::uint64_t m_itemsPerIteration = 1;
+	int m_threadIndex = 0;
+	int m_threadCount = 1;
+	std::atomic<int>* m_startLine = nullptr;
+	bool m_started = false;
+	std::chrono::steady_clock::time_point m_start;
+	std::chrono::steady_clock::time_point m_stop;
+	AllocationStats m_allocations;
+};
+
+// Benchmarks are registered in a linked list by static Benchmark objects.
+class Benchmark {
+  public:
+	Benchmark(const char* name, void (*function)(State&), bool threaded = false);
+
+	Benchmark(const Benchmark&) = delete;
+	Benchmark& operator=(const Benchmark&) = delete;
+
+	const char* name() const { return m_name; }
+	bool threaded() const { return m_threaded; }
+	void run(State& state) const { m_function(state); }
+
+	static const Benchmark* first();
+	const Benchmark* next() const { return m_next; }
+
+  private:
+	const char* m_name;
+	void (*m_function)(State&);
+	bool m_threaded;
+	const Benchmark* m_next;
+};
+
+// LatencyState drives an open-loop latency measurement: iterations are issued
+// at a fixed rate, independent of how long previous iterations took. Latency is
+// measured from the time an iteration was scheduled to start, so a stall also
+// counts against every iteration that had to wait for it. This corrects for
+// coordinated omission, where a closed loop only measures the one slow
+// iteration. The uncorrected latency, measured from the actual start, is kept
+// for comparison.
+class LatencyState {
+  public:
+	LatencyState(std::uint64_t iterations, std::chrono::nanoseconds interval)
+	    : m_iterations(iterations), m_interval(interval)
+	{}
+
+	bool keepRunning();
+
+	// Latencies in nanoseconds.
+	const HistogramSnapshot& corrected() const { return m_corrected; }
+	const HistogramSnapshot& uncorrected() const { return m_uncorrected; }
+
+  private:
+	std::uint64_t m_iterations;
+	std::uint64_t m_issued = 0;
+	std::chrono::nanoseconds m_interval;
+	std::chrono::steady_clock::time_point m_start;
+	std::chrono::steady_clock::time_point m_scheduled;
+	std::chrono::steady_clock::time_point m_actual;
+	HistogramSnapshot m_corrected;
+	HistogramSnapshot m_uncorrected;
+};
+
+class LatencyBenchmark {
+  public:
+	LatencyBenchmark(const char* name, void (*function)(LatencyState&));
+
+	LatencyBenchmark(const LatencyBenchmark&) = delete;
+	LatencyBenchmark& operator=(const LatencyBenchmark&) = delete;
+
+	const char* name() const { return m_name; }
+	void run(LatencyState& state) const { m_function(state); }
+
+	static const LatencyBenchmark* first();
+	const LatencyBenchmark* next() const { return m_next; }
+
+  private:
+	const char* m_name;
+	void (*m_function)(LatencyState&);
+	const LatencyBenchmark* m_next;
+};
+
+} // namespace Example::Bench
@@ -0,0 +1,106 @@
+#include <example_bench/example_bench.hpp>
+
+#include <example/example_checksum.hpp>
+#include <example/example_hello.hpp>
+#include <example/example_isa.hpp>
+#include <example/example_lines.hpp>
+#include <example/example_metrics.hpp>
+#include <example/example_trace.hpp>
+
+using namespace Example;
+using namespace Example::Bench;
+
+EXAMPLE_BENCHMARK("hello without name")
+{
+	while (state.keepRunning()) {
+		doNotOptimize(hello(""));
+	}
+}
+
+EXAMPLE_BENCHMARK("hello with name")
+{
+	while (state.keepRunning()) {
+		doNotOptimize(hello("Tim"));
+	}
+}
+
+EXAMPLE_BENCHMARK("hello appending")
+{
+	std::string greeting;
+	while (state.keepRunning()) {
+		greeting.clear();
+		hello(greeting, "Tim");
+		doNotOptimize(greeting);
+	}
+}
+
+EXAMPLE_BENCHMARK("LineScanner 1 MiB")
+{
+	std::string input;
+	std::size_t lines = 0;
+	while (input.size() < (1 << 20)) {
+		fmt::format_to(std::back_inserter(input), "Name {}\n", lines++);
+	}
+	state.setItemsPerIteration(lines);
+
+	while (state.keepRunning()) {
+		LineScanner scanner(input);
+		std::string_view line;
+		while (scanner.next(line)) {
+			doNotOptimize(line);
+		}
+	}
+}
+
+EXAMPLE_BENCHMARK("crc32c 1 MiB")
+{
+	const std::string input(1 << 20, 'x');
+	state.setItemsPerIteration(input.size());
+
+	while (state.keepRunning()) {
+		doNotOptimize(crc32c(input));
+	}
+}
+
+// The kernel every CPU can run, for comparison with the one selected above.
+EXAMPLE_BENCHMARK("crc32c 1 MiB baseline kernel")
+{
+	const std::string input(1 << 20, 'x');
+	state.setItemsPerIteration(input.size());
+
+	while (state.keepRunning()) {
+		doNotOptimize(baseline::crc32c(input.data(), input.size(), 0));
+	}
+}
+
+EXAMPLE_BENCHMARK("Counter add")
+{
+	static Counter counter("example_bench_counter_total", "Benchmark counter.");
+	while (state.keepRunning()) {
+		counter.add();
+	}
+}
+
+EXAMPLE_BENCHMARK("trace scope disabled")
+{
+	enableTracing(false);
+	while (state.keepRunning()) {
+		EXAMPLE_TRACE_SCOPE("bench");
+		doNotOptimize(state);
+	}
+}
+
+EXAMPLE_BENCHMARK("trace call disabled")
+{
+	enableTracing(false);
+	while (state.keepRunning()) {
+		traceCall("bench", [&] { doNotOptimize(state); });
+	}
+}
+
+EXAMPLE_BENCHMARK("hello with long name")
+{
+	while (state.keepRunning()) {
+		doNotOptimize(hello("Bartholomew Montgomery"));
+	}
+}
@@ -0,0 +1,210 @@
+#include <example_bench/example_bench_json.hpp>
+
+namespace Example::Bench {
+
+const JsonValue* JsonValue::find(std::string_view key) const
+{
+	for (const auto& [name, value] : object) {
+		if (name == key) {
+			return &value;
+		}
+	}
+	return nullptr;
+}
+
+double JsonValue::numberOr(std::string_view key, double fallback) const
+{
+	const JsonValue* value = find(key);
+	return value && value->type == Type::Number ? value->number : fallback;
+}
+
+std::string_view JsonValue::stringOr(std::string_view key, std::string_view fallback) const
+{
+	const JsonValue* value = find(key);
+	return value && value->type == Type::String ? std::string_view(value->string) : fallback;
+}
+
+namespace {
+
+bool isOneOf(char c, std::string_view set)
+{
+	return set.find(c) != std::string_view::npos;
+}
+
+class JsonParser {
+  public:
+	explicit JsonParser(std::string_view text) : m_text(text) {}
+
+	bool parseDocument(JsonValue& outValue)
+	{
+		if (!parseValue(outValue, 0)) {
+			return false;
+		}
+		skipWhitespace();
+		return m_position == m_text.size();
+	}
+
+  private:
+	static constexpr int MaxDepth = 64;
+
+	bool parseValue(JsonValue& outValue, int depth)
+	{
+		if (depth > MaxDepth) {
+			return false;
+		}
+
+		skipWhitespace();
+		if (m_position == m_text.size()) {
+			return false;
+		}
+
+		switch (m_text[m_position]) {
+		case '{': return parseObject(outValue, depth);
+		case '[': return parseArray(outValue, depth);
+		case '"': outValue.type = JsonValue::Type::String; return parseString(outValue.string);
+		case 't': outValue.type = JsonValue::Type::Bool; outValue.boolean = true; return consume("true");
+		case 'f': outValue.type = JsonValue::Type::Bool; outValue.boolean = false; return consume("false");
+		case 'n': outValue.type = JsonValue::Type::Null; return consume("null");
+		default: outValue.type = JsonValue::Type::Number; return parseNumber(outValue.number);
+		}
+	}
+
+	bool parseObject(JsonValue& outValue, int depth)
+	{
+		outValue.type = JsonValue::Type::Object;
+		m_position++;
+		skipWhitespace();
+		if (consume("}")) {
+			return true;
+		}
+		while (true) {
+			skipWhitespace();
+			std::string key;
+			if (!parseString(key)) {
+				return false;
+			}
+			skipWhitespace();
+			if (!consume(":")) {
+				return false;
+			}
+			JsonValue value;
+			if (!parseValue(value, depth + 1)) {
+				return false;
+			}
+			outValue.object.emplace_back(std::move(key), std::move(value));
+			skipWhitespace();
+			if (consume("}")) {
+				return true;
+			}
+			if (!consume(",")) {
+				return false;
+			}
+		}
+	}
+
+	bool parseArray(JsonValue& outValue, int depth)
+	{
+		outValue.type = JsonValue::Type::Array;
+		m_position++;
+		skipWhitespace();
+		if (consume("]")) {
+			return true;
+		}
+		while (true) {
+			JsonValue value;
+			if (!parseValue(value, depth + 1)) {
+				return false;
+			}
+			outValue.array.push_back(std::move(value));
+			skipWhitespace();
+			if (consume("]")) {
+				return true;
+			}
+			if (!consume(",")) {
+				return false;
+			}
+		}
+	}
+
+	// Escapes are decoded, except for \u which is only supported for ASCII.
+	bool parseString(std::string& outString)
+	{
+		if (!consume("\"")) {
+			return false;
+		}
+		while (m_position < m_text.size()) {
+			const char c = m_text[m_position++];
+			if (c == '"') {
+				return true;
+			}
+			if (c != '\\') {
+				outString += c;
+				continue;
+			}
+			if (m_position == m_text.size()) {
+				return false;
+			}
+			switch (const char escaped = m_text[m_position++]) {
+			case 'n': outString += '\n'; break;
+			case 't': outString += '\t'; break;
+			case 'r': outString += '\r'; break;
+			case 'b': outString += '\b'; break;
+			case 'f': outString += '\f'; break;
+			case 'u': {
+				if (m_text.size() - m_position < 4) {
+					return false;
+				}
+				const auto code = std::strtoul(std::string(m_text.substr(m_position, 4)).c_str(), nullptr, 16);
+				outString += code < 0x80 ? char(code) : '?';
+				m_position += 4;
+				break;
+			}
+			default: outString += escaped; break;
+			}
+		}
+		return false;
+	}
+
+	bool parseNumber(double& outNumber)
+	{
+		const std::size_t begin = m_position;
+		while (m_position < m_text.size() && isOneOf(m_text[m_position], "+-.0123456789eE")) {
+			m_position++;
+		}
+		if (begin == m_position) {
+			return false;
+		}
+		const std::string number(m_text.substr(begin, m_position - begin));
+		char* end;
+		outNumber = std::strtod(number.c_str(), &end);
+		return end == number.c_str() + number.size();
+	}
+
+	bool consume(std::string_view token)
+	{
+		if (m_text.substr(m_position).starts_with(token)) {
+			m_position += token.size();
+			return true;
+		}
+		return false;
+	}
+
+	void skipWhitespace()
+	{
+		while (m_position < m_text.size() && isOneOf(m_text[m_position], " \t\r\n")) {
+			m_position++;
+		}
+	}
+
+	std::string_view m_text;
+	std::size_t m_position = 0;
+};
+
+} // namespace
+
+bool parseJson(JsonValue& outValue, std::string_view text)
+{
+	return JsonParser(text).parseDocument(outValue);
+}
+
+} // namespace Example::Bench
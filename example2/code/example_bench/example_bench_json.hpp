@@ -0,0 +1,23 @@
+#pragma once
+
+namespace Example::Bench {
+
+// Just enough JSON for reading back benchmark result files.
+struct JsonValue {
+	enum class Type { Null, Bool, Number, String, Array, Object };
+
+	const JsonValue* find(std::string_view key) const;
+	double numberOr(std::string_view key, double fallback) const;
+	std::string_view stringOr(std::string_view key, std::string_view fallback) const;
+
+	Type type = Type::Null;
+	bool boolean = false;
+	double number = 0.0;
+	std::string string;
+	std::vector<JsonValue> array;
+	std::vector<std::pair<std::string, JsonValue>> object;
+};
+
+bool parseJson(JsonValue& outValue, std::string_view text);
+
+} // namespace Example::Bench
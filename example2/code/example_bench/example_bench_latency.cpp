@@ -0,0 +1,31 @@
+#include <example_bench/example_bench.hpp>
+
+#include <example/example_hello.hpp>
+#include <example/example_logger_file.hpp>
+
+using namespace Example;
+using namespace Example::Bench;
+
+EXAMPLE_LATENCY_BENCHMARK("hello with name")
+{
+	while (state.keepRunning()) {
+		doNotOptimize(hello("Tim"));
+	}
+}
+
+// Logs to an actual file, such that the stream occasionally writing out its
+// buffer shows up in the tail latencies.
+EXAMPLE_LATENCY_BENCHMARK("FileLogger log")
+{
+	constexpr const char* filename = "example_bench_latency.log";
+	{
+		std::unique_ptr<FileLogger> logger;
+		if (!FileLogger::create(logger, filename).ok()) {
+			return;
+		}
+		while (state.keepRunning()) {
+			logger->log("Example::hello called");
+		}
+	}
+	std::remove(filename);
+}
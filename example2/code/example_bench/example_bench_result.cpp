@@ -0,0 +1,175 @@
+#include <example_bench/example_bench.hpp>
+
+#include <example/example_result.hpp>
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+// Example::Result stays qualified: unity builds merge this file with the
+// harness, which has a Result of its own.
+using namespace Example::Bench;
+using Example::Status;
+using Example::StatusCode;
+
+// Result against out-parameters and std::expected (where available), for a
+// small value returned in registers and a large buffer constructed in place.
+// The functions are kept out of line, the calling convention is part of what
+// is measured.
+
+#if defined(_MSC_VER)
+#define EXAMPLE_BENCH_NOINLINE __declspec(noinline)
+#else
+#define EXAMPLE_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+using Buffer = std::array<char, 4096>;
+
+constexpr std::string_view Numbers[] = {"12345", "987654321", "42", "x17", "31337", "271828", "1", "161803"};
+
+EXAMPLE_BENCH_NOINLINE Status parseOut(std::uint64_t& outValue, std::string_view text)
+{
+	std::uint64_t value = 0;
+	for (char c : text) {
+		if (c < '0' || c > '9') {
+			return StatusCode::InvalidArgument;
+		}
+		value = value * 10 + std::uint64_t(c - '0');
+	}
+	outValue = value;
+	return {};
+}
+
+EXAMPLE_BENCH_NOINLINE Example::Result<std::uint64_t> parseResult(std::string_view text)
+{
+	std::uint64_t value = 0;
+	for (char c : text) {
+		if (c < '0' || c > '9') {
+			return StatusCode::InvalidArgument;
+		}
+		value = value * 10 + std::uint64_t(c - '0');
+	}
+	return value;
+}
+
+EXAMPLE_BENCH_NOINLINE Status fillOut(Buffer& outBuffer, char c)
+{
+	if (c == 0) {
+		return StatusCode::InvalidArgument;
+	}
+	outBuffer.fill(c);
+	return {};
+}
+
+// Returns the same Result on every path, such that it is constructed in the
+// caller's storage, see Result::setError.
+EXAMPLE_BENCH_NOINLINE Example::Result<Buffer> fillResult(char c)
+{
+	Example::Result<Buffer> result(std::in_place);
+	if (c == 0) {
+		result.setError(StatusCode::InvalidArgument);
+		return result;
+	}
+	result->fill(c);
+	return result;
+}
+
+#if defined(__cpp_lib_expected)
+
+EXAMPLE_BENCH_NOINLINE std::expected<std::uint64_t, Status> parseExpected(std::string_view text)
+{
+	std::uint64_t value = 0;
+	for (char c : text) {
+		if (c < '0' || c > '9') {
+			return std::unexpected(Status(StatusCode::InvalidArgument));
+		}
+		value = value * 10 + std::uint64_t(c - '0');
+	}
+	return value;
+}
+
+EXAMPLE_BENCH_NOINLINE std::expected<Buffer, Status> fillExpected(char c)
+{
+	if (c == 0) {
+		return std::unexpected(Status(StatusCode::InvalidArgument));
+	}
+	std::expected<Buffer, Status> result(std::in_place);
+	result->fill(c);
+	return result;
+}
+
+#endif
+
+} // namespace
+
+EXAMPLE_BENCHMARK("parse number out-parameter")
+{
+	std::size_t i = 0;
+	while (state.keepRunning()) {
+		std::uint64_t value = 0;
+		if (parseOut(value, Numbers[i++ % std::size(Numbers)]).ok()) {
+			doNotOptimize(value);
+		}
+	}
+}
+
+EXAMPLE_BENCHMARK("parse number Result")
+{
+	std::size_t i = 0;
+	while (state.keepRunning()) {
+		const Example::Result<std::uint64_t> value = parseResult(Numbers[i++ % std::size(Numbers)]);
+		if (value.ok()) {
+			doNotOptimize(*value);
+		}
+	}
+}
+
+EXAMPLE_BENCHMARK("fill 4 KiB buffer out-parameter")
+{
+	Buffer buffer;
+	char c = 1;
+	while (state.keepRunning()) {
+		if (fillOut(buffer, c++ | 1).ok()) {
+			doNotOptimize(buffer);
+		}
+	}
+}
+
+EXAMPLE_BENCHMARK("fill 4 KiB buffer Result")
+{
+	char c = 1;
+	while (state.keepRunning()) {
+		const Example::Result<Buffer> buffer = fillResult(c++ | 1);
+		if (buffer.ok()) {
+			doNotOptimize(*buffer);
+		}
+	}
+}
+
+#if defined(__cpp_lib_expected)
+
+EXAMPLE_BENCHMARK("parse number std::expected")
+{
+	std::size_t i = 0;
+	while (state.keepRunning()) {
+		const std::expected<std::uint64_t, Status> value = parseExpected(Numbers[i++ % std::size(Numbers)]);
+		if (value.has_value()) {
+			doNotOptimize(*value);
+		}
+	}
+}
+
+EXAMPLE_BENCHMARK("fill 4 KiB buffer std::expected")
+{
+	char c = 1;
+	while (state.keepRunning()) {
+		const std::expected<Buffer, Status> buffer = fillExpected(c++ | 1);
+		if (buffer.has_value()) {
+			doNotOptimize(*buffer);
+		}
+	}
+}
+
+#endif
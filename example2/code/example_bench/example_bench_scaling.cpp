@@ -0,0 +1,123 @@
+#include <example_bench/example_bench.hpp>
+
+#include <fcntl.h>
+#include <mutex>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <example/example_hello.hpp>
+#include <example/example_logger_console.hpp>
+#include <example/example_logger_file.hpp>
+#include <example/example_platform.hpp>
+
+using namespace Example;
+using namespace Example::Bench;
+
+// Shared state like metrics, the logger's stream lock, or the platform shows up
+// as contention once several threads hit the same path.
+
+#if defined(_WIN32)
+static constexpr const char* NullDevice = "NUL";
+static int duplicateFd(int fd) { return _dup(fd); }
+static void redirectFd(int from, int to) { _dup2(from, to); }
+static void closeFd(int fd) { _close(fd); }
+static int openNullDevice() { return _open(NullDevice, _O_WRONLY); }
+#else
+static constexpr const char* NullDevice = "/dev/null";
+static int duplicateFd(int fd) { return dup(fd); }
+static void redirectFd(int from, int to) { dup2(from, to); }
+static void closeFd(int fd) { close(fd); }
+static int openNullDevice() { return open(NullDevice, O_WRONLY | O_CLOEXEC); }
+#endif
+
+// Points the stdout descriptor at the null device while at least one thread
+// holds a NullStdout. std::cout keeps its own, stdio-synchronized buffer and
+// lock, only the output goes nowhere. The harness prints to stdout as well, so
+// the descriptor is restored once the last thread is done.
+class NullStdout {
+  public:
+	NullStdout()
+	{
+		const std::lock_guard lock(s_mutex);
+		if (s_users++ == 0) {
+			std::cout.flush();
+			std::fflush(stdout);
+			s_stdout = duplicateFd(1);
+			const int null = openNullDevice();
+			redirectFd(null, 1);
+			closeFd(null);
+		}
+	}
+
+	~NullStdout() noexcept
+	{
+		const std::lock_guard lock(s_mutex);
+		if (--s_users == 0) {
+			std::cout.flush();
+			std::fflush(stdout);
+			redirectFd(s_stdout, 1);
+			closeFd(s_stdout);
+		}
+	}
+
+	NullStdout(const NullStdout&) = delete;
+	NullStdout& operator=(const NullStdout&) = delete;
+
+  private:
+	static inline std::mutex s_mutex;
+	static inline int s_users = 0;
+	static inline int s_stdout = -1;
+};
+
+EXAMPLE_BENCHMARK_THREADED("hello with name")
+{
+	while (state.keepRunning()) {
+		doNotOptimize(hello("Tim"));
+	}
+}
+
+EXAMPLE_BENCHMARK_THREADED("hello appending")
+{
+	std::string greeting;
+	while (state.keepRunning()) {
+		greeting.clear();
+		hello(greeting, "Tim");
+		doNotOptimize(greeting);
+	}
+}
+
+// All threads share one logger, like they share g_logger. The console logger
+// writes to the null device instead of the terminal.
+EXAMPLE_BENCHMARK_THREADED("ConsoleLogger log")
+{
+	static const auto logger = ConsoleLogger::create();
+	const NullStdout nullStdout;
+
+	while (state.keepRunning()) {
+		logger->log("Example::hello called");
+	}
+}
+
+EXAMPLE_BENCHMARK_THREADED("FileLogger log")
+{
+	static std::unique_ptr<FileLogger> logger;
+	static const Status status = FileLogger::create(logger, NullDevice);
+	if (!status.ok()) {
+		return;
+	}
+
+	while (state.keepRunning()) {
+		logger->log("Example::hello called");
+	}
+}
+
+EXAMPLE_BENCHMARK_THREADED("Platform cpuCount")
+{
+	while (state.keepRunning()) {
+		doNotOptimize(Platform::get().cpuCount());
+	}
+}
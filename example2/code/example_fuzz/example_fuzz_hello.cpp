@@ -0,0 +1,315 @@
+#include <example/example_checksum.hpp>
+#include <example/example_columnar.hpp>
+#include <example/example_hello.hpp>
+#include <example/example_lines.hpp>
+#include <example/example_metrics.hpp>
+#include <example/example_output.hpp>
+
+#if !defined(EXAMPLE_FUZZ_LIBFUZZER)
+#include <filesystem>
+#include <random>
+#endif
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// Differential fuzz target for the greeting paths. The input is treated as a
+// batch file; every fast path must produce exactly what the straightforward
+// reference implementation produces:
+// - LineScanner (SIMD newline search) against splitting at each '\n'
+// - hello appending into an existing string against hello returning one
+// - OutputWriter output against the concatenated greetings
+// - columnar files against the greetings they were written from
+// - crc32c against a bitwise implementation
+//
+// Mismatches abort, which libFuzzer reports as a crash. Built without
+// libFuzzer, a replay main runs corpus files and random inputs instead.
+//
+// The greeting paths are timed per input. Inputs that take far longer per byte
+// than usual are reported as pathological, together with what stands out
+// about them (huge names, invalid UTF-8).
+
+namespace {
+
+void check(bool condition, const char* what)
+{
+	if (!condition) {
+		fmt::print(stderr, "Mismatch: {}\n", what);
+		std::abort();
+	}
+}
+
+std::vector<std::string_view> referenceSplit(std::string_view data)
+{
+	std::vector<std::string_view> lines;
+	while (!data.empty()) {
+		const auto end = data.find('\n');
+		std::string_view line = data.substr(0, end);
+		data.remove_prefix(end == std::string_view::npos ? data.size() : end + 1);
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+std::uint32_t referenceCrc32c(std::string_view data)
+{
+	std::uint32_t crc = 0xFFFFFFFF;
+	for (char c : data) {
+		crc ^= std::uint8_t(c);
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0x82F63B78 & (0u - (crc & 1)));
+		}
+	}
+	return ~crc;
+}
+
+bool isValidUtf8(std::string_view data)
+{
+	for (std::size_t i = 0; i < data.size();) {
+		const auto lead = std::uint8_t(data[i]);
+		std::size_t length = 1;
+		std::uint32_t codePoint = lead;
+		if (lead >= 0xF0 && lead <= 0xF4) {
+			length = 4;
+			codePoint = lead & 0x07u;
+		}
+		else if (lead >= 0xE0) {
+			length = lead <= 0xEF ? 3 : 0;
+			codePoint = lead & 0x0Fu;
+		}
+		else if (lead >= 0xC2) {
+			length = 2;
+			codePoint = lead & 0x1Fu;
+		}
+		else if (lead >= 0x80) {
+			length = 0;
+		}
+		if (length == 0 || i + length > data.size()) {
+			return false;
+		}
+		for (std::size_t j = 1; j < length; j++) {
+			const auto continuation = std::uint8_t(data[i + j]);
+			if ((continuation & 0xC0) != 0x80) {
+				return false;
+			}
+			codePoint = (codePoint << 6) | (continuation & 0x3Fu);
+		}
+		// Overlong encodings, surrogates and values beyond Unicode.
+		if ((length == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)))
+		    || (length == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF))) {
+			return false;
+		}
+		i += length;
+	}
+	return true;
+}
+
+std::string readAll(std::FILE* file)
+{
+	std::string content;
+	char buffer[4096];
+	std::rewind(file);
+	while (const std::size_t length = std::fread(buffer, 1, sizeof(buffer), file)) {
+		content.append(buffer, length);
+	}
+	return content;
+}
+
+// Time per byte of all inputs so far, pathological inputs stand out against
+// its median.
+Example::HistogramSnapshot g_picosecondsPerByte;
+std::uint64_t g_pathologicalInputs = 0;
+
+constexpr std::size_t HugeNameSize = 4096;
+constexpr std::uint64_t PathologicalFactor = 20;
+
+void checkGreetings(std::string_view input, const std::vector<std::string_view>& lines,
+                    const std::vector<std::string>& greetings)
+{
+	std::string expectedText;
+	for (const std::string& greeting : greetings) {
+		expectedText += greeting;
+		expectedText += '\n';
+	}
+
+	if (std::FILE* file = std::tmpfile()) {
+		auto output = Example::OutputWriter::create(file);
+		check(output != nullptr, "OutputWriter::create");
+		for (const std::string& greeting : greetings) {
+			output->write(greeting);
+			output->write("\n");
+		}
+		check(output->flush(), "OutputWriter::flush");
+		output.reset();
+		check(readAll(file) == expectedText, "OutputWriter content");
+		std::fclose(file);
+	}
+
+	// Columnar round trips involve the file system, large inputs are skipped
+	// to keep the fuzzer fast.
+	if (lines.size() <= 1024) {
+		const std::string filename = fmt::format("example_fuzz_{}.col", getpid());
+		auto writer = Example::ColumnarWriter::create(filename);
+		check(writer != nullptr, "ColumnarWriter::create");
+		for (const std::string& greeting : greetings) {
+			writer->add(greeting);
+		}
+		check(writer->finish(), "ColumnarWriter::finish");
+		writer.reset();
+
+		const auto reader = Example::ColumnarReader::open(filename);
+		check(reader != nullptr, "ColumnarReader::open");
+		check(reader->size() == greetings.size(), "columnar size");
+		for (std::size_t i = 0; i < greetings.size(); i++) {
+			check((*reader)[i] == greetings[i], "columnar value");
+		}
+		std::remove(filename.c_str());
+	}
+
+	check(Example::crc32c(input) == referenceCrc32c(input), "crc32c");
+	if (input.size() > 1) {
+		const std::size_t split = input.size() / 3;
+		check(Example::crc32c(input.substr(split), Example::crc32c(input.substr(0, split))) == referenceCrc32c(input),
+		      "crc32c incremental");
+	}
+}
+
+void reportIfPathological(std::string_view input, const std::vector<std::string_view>& lines,
+                          std::chrono::nanoseconds elapsed)
+{
+	const auto picosecondsPerByte = std::uint64_t(elapsed.count()) * 1000 / (input.size() + 1);
+	const std::uint64_t median = g_picosecondsPerByte.percentile(50.0);
+	g_picosecondsPerByte.record(picosecondsPerByte);
+
+	if (g_picosecondsPerByte.count < 100 || picosecondsPerByte < median * PathologicalFactor) {
+		return;
+	}
+	g_pathologicalInputs++;
+
+	std::size_t longestLine = 0;
+	for (std::string_view line : lines) {
+		longestLine = std::max(longestLine, line.size());
+	}
+	fmt::print(stderr, "Pathological input: {} bytes, {} lines, {} us ({}x median per byte){}{}, crc32c {:08x}\n",
+	           input.size(), lines.size(), elapsed.count() / 1000, picosecondsPerByte / std::max<std::uint64_t>(median, 1),
+	           longestLine >= HugeNameSize ? ", huge name" : "", isValidUtf8(input) ? "" : ", invalid UTF-8",
+	           referenceCrc32c(input));
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+	const std::string_view input(reinterpret_cast<const char*>(data), size);
+
+	// Only the greeting paths are timed, file system round trips would drown
+	// them out.
+	const auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::string_view> lines;
+	Example::LineScanner scanner(input);
+	for (std::string_view line; scanner.next(line);) {
+		lines.push_back(line);
+	}
+
+	std::vector<std::string> greetings;
+	std::string appended = "> ";
+	for (std::string_view line : lines) {
+		greetings.push_back(Example::hello(line));
+
+		appended.resize(2);
+		Example::hello(appended, line);
+		check(std::string_view(appended).substr(2) == greetings.back(), "hello appending");
+	}
+
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	check(lines == referenceSplit(input), "LineScanner");
+	checkGreetings(input, lines, greetings);
+	reportIfPathological(input, lines, elapsed);
+	return 0;
+}
+
+#if !defined(EXAMPLE_FUZZ_LIBFUZZER)
+
+static void runFile(const std::filesystem::path& path)
+{
+	std::FILE* file = std::fopen(path.string().c_str(), "rb");
+	if (!file) {
+		fmt::print(stderr, "Could not open {}\n", path.string());
+		std::exit(1);
+	}
+	const std::string content = readAll(file);
+	std::fclose(file);
+	LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(content.data()), content.size());
+}
+
+// Random inputs are biased towards what matters here: newlines, carriage
+// returns, bytes that are invalid UTF-8, and the occasional huge name.
+static std::string randomInput(std::mt19937_64& random)
+{
+	const std::size_t size = random() % 64 == 0 ? random() % (1 << 20) : random() % 512;
+	std::string input(size, 'x');
+	for (char& c : input) {
+		switch (random() % 8) {
+		case 0: c = '\n'; break;
+		case 1: c = '\r'; break;
+		case 2: c = char(0x80 + random() % 0x80); break;
+		default: c = char('a' + random() % 26); break;
+		}
+	}
+	return input;
+}
+
+int main(int argc, char* argv[])
+{
+	int randomInputs = 0;
+	std::vector<std::filesystem::path> paths;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		if (arg == "--random" && i + 1 < argc) {
+			randomInputs = std::atoi(argv[++i]);
+		}
+		else if (!arg.starts_with("--")) {
+			paths.emplace_back(arg);
+		}
+		else {
+			fmt::print("usage: {} [--random <count>] [<file or directory>...]\n\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::size_t inputs = 0;
+	for (const auto& path : paths) {
+		if (std::filesystem::is_directory(path)) {
+			for (const auto& entry : std::filesystem::directory_iterator(path)) {
+				runFile(entry.path());
+				inputs++;
+			}
+		}
+		else {
+			runFile(path);
+			inputs++;
+		}
+	}
+
+	std::mt19937_64 random(42);
+	for (int i = 0; i < randomInputs; i++) {
+		const std::string input = randomInput(random);
+		LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+		inputs++;
+	}
+
+	fmt::print("Ran {} inputs, median {} ps per byte, {} pathological\n", inputs,
+	           g_picosecondsPerByte.percentile(50.0), g_pathologicalInputs);
+	return 0;
+}
+
+#endif
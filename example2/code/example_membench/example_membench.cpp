@@ -0,0 +1,339 @@
+#include <example/example_platform.hpp>
+
+#include <filesystem>
+#include <random>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// example_membench measures memory latency by pointer chasing through working
+// sets of increasing size, and streaming bandwidth for memory on each NUMA
+// node. The latency curve is cross-checked against the cache sizes reported by
+// the Platform: a working set half the size of a cache must be noticeably
+// faster than one twice its size. Buffer sizing decisions rely on these
+// values, a mismatch makes the run fail.
+
+struct Options {
+	std::size_t maxSize = std::size_t(1) << 30;
+	int cpu = 0;
+	bool check = true;
+};
+
+static bool parseOptions(Options& outOptions, int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--max-size" && hasValue) {
+			outOptions.maxSize = std::size_t(std::max(std::atoi(argv[++i]), 1)) << 20;
+		}
+		else if (arg == "--cpu" && hasValue) {
+			outOptions.cpu = std::atoi(argv[++i]);
+		}
+		else if (arg == "--no-check") {
+			outOptions.check = false;
+		}
+		else {
+			return false;
+		}
+	}
+	return true;
+}
+
+static std::string formatSize(std::size_t size)
+{
+	if (size >= (std::size_t(1) << 30) && size % (std::size_t(1) << 30) == 0) {
+		return fmt::format("{} GiB", size >> 30);
+	}
+	if (size >= (std::size_t(1) << 20) && size % (std::size_t(1) << 20) == 0) {
+		return fmt::format("{} MiB", size >> 20);
+	}
+	if (size >= (std::size_t(1) << 10)) {
+		return fmt::format("{} KiB", size >> 10);
+	}
+	return fmt::format("{} B", size);
+}
+
+// Memory is mapped directly, such that it can be bound to a NUMA node and is
+// not recycled from earlier, differently placed allocations.
+class Buffer {
+  public:
+	explicit Buffer(std::size_t size) : m_size(size)
+	{
+#if defined(__linux__)
+		void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		m_data = data == MAP_FAILED ? nullptr : static_cast<std::byte*>(data);
+#else
+		m_data = static_cast<std::byte*>(std::malloc(size));
+#endif
+	}
+
+	~Buffer() noexcept
+	{
+#if defined(__linux__)
+		if (m_data) {
+			munmap(m_data, m_size);
+		}
+#else
+		std::free(m_data);
+#endif
+	}
+
+	Buffer(const Buffer&) = delete;
+	Buffer& operator=(const Buffer&) = delete;
+
+	// Binds the not yet touched memory to the given node. Uses the system call
+	// directly, libnuma is not required.
+	bool bindToNode(int node)
+	{
+#if defined(__linux__) && defined(SYS_mbind)
+		constexpr int MPOL_BIND = 2;
+		constexpr std::size_t MaxNodes = 1024;
+		constexpr std::size_t BitsPerWord = sizeof(unsigned long) * 8;
+		if (node < 0 || std::size_t(node) >= MaxNodes) {
+			return false;
+		}
+		unsigned long mask[MaxNodes / BitsPerWord] = {};
+		mask[std::size_t(node) / BitsPerWord] = 1ul << (std::size_t(node) % BitsPerWord);
+		return syscall(SYS_mbind, m_data, m_size, MPOL_BIND, mask, MaxNodes, 0) == 0;
+#else
+		(void)node;
+		return node == 0;
+#endif
+	}
+
+	std::byte* data() const { return m_data; }
+	std::size_t size() const { return m_size; }
+
+  private:
+	std::byte* m_data = nullptr;
+	std::size_t m_size;
+};
+
+// Returns the IDs of the NUMA nodes, which need not be contiguous. Falls back to
+// 0 up to the Platform's node count where sysfs is not available.
+static std::vector<int> numaNodeIds(int nodeCount)
+{
+	std::vector<int> nodes;
+#if defined(__linux__)
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+		const std::string name = entry.path().filename().string();
+		if (name.size() > 4 && name.starts_with("node")
+		    && name.find_first_not_of("0123456789", 4) == std::string::npos) {
+			nodes.push_back(std::atoi(name.c_str() + 4));
+		}
+	}
+	std::sort(nodes.begin(), nodes.end());
+#endif
+	if (nodes.empty()) {
+		for (int node = 0; node < nodeCount; node++) {
+			nodes.push_back(node);
+		}
+	}
+	return nodes;
+}
+
+// Links the cache lines of the buffer into a single random cycle and follows
+// it. Every load depends on the previous one, the random order defeats the
+// prefetchers. Loads are volatile, such that the chase is not optimized away.
+// Returns nanoseconds per load.
+static double measureLatency(Buffer& buffer, std::size_t size, std::size_t lineSize)
+{
+	const std::size_t count = size / lineSize;
+	std::vector<std::size_t> order(count);
+	for (std::size_t i = 0; i < count; i++) {
+		order[i] = i;
+	}
+	std::shuffle(order.begin() + 1, order.end(), std::mt19937_64(42));
+
+	std::byte* const data = buffer.data();
+	for (std::size_t i = 0; i < count; i++) {
+		void* next = data + order[(i + 1) % count] * lineSize;
+		std::memcpy(data + order[i] * lineSize, &next, sizeof(next));
+	}
+
+	// Warm up, then chase long enough to amortize the timer.
+	constexpr std::size_t loads = std::size_t(1) << 22;
+	void* position = data;
+	for (std::size_t i = 0; i < std::min(count, loads); i++) {
+		position = *static_cast<void* volatile*>(position);
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < loads; i += 8) {
+		position = *static_cast<void* volatile*>(position);
+		position = *static_cast<void* volatile*>(position);
+		position = *static_cast<void* volatile*>(position);
+		position = *static_cast<void* volatile*>(position);
+		position = *static_cast<void* volatile*>(position);
+		position = *static_cast<void* volatile*>(position);
+		position = *static_cast<void* volatile*>(position);
+		position = *static_cast<void* volatile*>(position);
+	}
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / double(loads);
+}
+
+struct Bandwidth {
+	double read = 0.0; // <- bytes per second
+	double write = 0.0;
+};
+
+// Best of several passes over the whole buffer, reading words and summing them
+// up, or filling the buffer.
+static Bandwidth measureBandwidth(Buffer& buffer)
+{
+	auto* const words = reinterpret_cast<std::uint64_t*>(buffer.data());
+	const std::size_t count = buffer.size() / sizeof(std::uint64_t);
+
+	Bandwidth best;
+	for (int pass = 0; pass < 5; pass++) {
+		auto start = std::chrono::steady_clock::now();
+		std::memset(words, pass, buffer.size());
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		best.write = std::max(best.write, double(buffer.size()) / elapsed.count());
+
+		start = std::chrono::steady_clock::now();
+		std::uint64_t sum[4] = {};
+		for (std::size_t i = 0; i + 4 <= count; i += 4) {
+			sum[0] += words[i];
+			sum[1] += words[i + 1];
+			sum[2] += words[i + 2];
+			sum[3] += words[i + 3];
+		}
+		elapsed = std::chrono::steady_clock::now() - start;
+		best.read = std::max(best.read, double(buffer.size()) / elapsed.count());
+
+		volatile std::uint64_t sink = sum[0] + sum[1] + sum[2] + sum[3];
+		(void)sink;
+	}
+	return best;
+}
+
+// Working sets grow in steps of sqrt(2), rounded to whole cache lines.
+static std::vector<std::size_t> workingSetSizes(std::size_t lineSize, std::size_t maxSize)
+{
+	std::vector<std::size_t> sizes;
+	for (std::size_t size = 4 << 10; size <= maxSize; size *= 2) {
+		sizes.push_back(size);
+		const auto between = std::size_t(double(size) * 1.4142135623730951) / lineSize * lineSize;
+		if (between <= maxSize) {
+			sizes.push_back(between);
+		}
+	}
+	return sizes;
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions(options, argc, argv)) {
+		fmt::print("usage: {} [--max-size <MiB>] [--cpu <index>|-1] [--no-check]\n\n", argv[0]);
+		return 1;
+	}
+
+#if defined(__linux__)
+	if (options.cpu >= 0) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(std::size_t(options.cpu), &set);
+		if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+			fmt::print(stderr, "Could not pin to CPU {}, running unpinned\n", options.cpu);
+		}
+	}
+#endif
+
+	if (const Example::Status status = Example::Platform::initialize(); !status.ok()) {
+		fmt::print(stderr, "Could not initialize platform: {}\n", status.message());
+		return 1;
+	}
+	auto& platform = Example::Platform::get();
+
+	const std::size_t lineSize = platform.cacheLineSize() ? platform.cacheLineSize() : 64;
+	std::size_t cacheSizes[4] = {};
+	fmt::print("\nPlatform reports {} CPUs, {} NUMA nodes, {} byte cache lines\n", platform.cpuCount(),
+	           platform.numaNodeCount(), platform.cacheLineSize());
+	for (int level = 1; level <= 4; level++) {
+		cacheSizes[level - 1] = platform.cacheSize(level);
+		if (cacheSizes[level - 1]) {
+			fmt::print("  L{} {}\n", level, formatSize(cacheSizes[level - 1]));
+		}
+	}
+
+	// Twice the largest cache is needed to measure memory latency.
+	const std::size_t largestCache = *std::max_element(std::begin(cacheSizes), std::end(cacheSizes));
+	const std::size_t maxSize = std::min(std::max(largestCache * 4, std::size_t(64) << 20), options.maxSize);
+
+	Buffer buffer(maxSize);
+	if (!buffer.data()) {
+		fmt::print(stderr, "Could not allocate {}\n", formatSize(maxSize));
+		return 1;
+	}
+
+	fmt::print("\n{:>12} {:>12}\n", "working set", "latency");
+	std::vector<std::pair<std::size_t, double>> latencies;
+	for (std::size_t size : workingSetSizes(lineSize, maxSize)) {
+		latencies.emplace_back(size, measureLatency(buffer, size, lineSize));
+		fmt::print("{:>12} {:>9.2f} ns\n", formatSize(size), latencies.back().second);
+	}
+
+	// Latency for the measured working set closest to the given size.
+	const auto latencyAt = [&](std::size_t size) {
+		auto best = latencies.front();
+		for (const auto& entry : latencies) {
+			if (std::abs(double(entry.first) - double(size)) < std::abs(double(best.first) - double(size))) {
+				best = entry;
+			}
+		}
+		return best;
+	};
+
+	bool consistent = true;
+	fmt::print("\nCache sizes against latency (half vs. twice the size):\n");
+	for (int level = 1; level <= 4; level++) {
+		const std::size_t size = cacheSizes[level - 1];
+		if (size == 0) {
+			continue;
+		}
+		if (size * 2 > maxSize) {
+			fmt::print("  L{} {}: not checked, exceeds --max-size\n", level, formatSize(size));
+			continue;
+		}
+
+		const auto [insideSize, inside] = latencyAt(size / 2);
+		const auto [outsideSize, outside] = latencyAt(size * 2);
+		const bool ok = outside > inside * 1.3;
+		consistent &= ok;
+		fmt::print("  L{} {}: {:.2f} ns at {}, {:.2f} ns at {}{}\n", level, formatSize(size), inside,
+		           formatSize(insideSize), outside, formatSize(outsideSize), ok ? "" : "  MISMATCH");
+	}
+
+	// Bandwidth is measured on a buffer well beyond the caches.
+	const std::size_t bandwidthSize = std::min(std::max(largestCache * 4, std::size_t(256) << 20), options.maxSize);
+	fmt::print("\nStreaming bandwidth for {} from CPU {}:\n", formatSize(bandwidthSize), std::max(options.cpu, 0));
+	for (const int node : numaNodeIds(platform.numaNodeCount())) {
+		Buffer nodeBuffer(bandwidthSize);
+		if (!nodeBuffer.data()) {
+			fmt::print(stderr, "Could not allocate {}\n", formatSize(bandwidthSize));
+			return 1;
+		}
+		const bool bound = nodeBuffer.bindToNode(node);
+		const Bandwidth bandwidth = measureBandwidth(nodeBuffer);
+		fmt::print("  node {}: read {:.1f} GB/s, write {:.1f} GB/s{}\n", node, bandwidth.read / 1e9,
+		           bandwidth.write / 1e9, bound ? "" : " (memory not bound to node)");
+	}
+
+	Example::Platform::finalize();
+
+	if (options.check && !consistent) {
+		fmt::print(stderr, "\nMeasured latencies do not match the reported cache sizes\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+// example_startup_bench spawns the given command repeatedly and measures the
+// time from exec until the first byte shows up on its stdout, as well as the
+// time until the process exited. It has no dependencies on the example library
+// so it doesn't influence what it measures.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Sample {
+	double firstOutputUs = 0.0;
+	double exitUs = 0.0;
+};
+
+bool runOnce(char** command, Sample& sample)
+{
+	int fds[2];
+	if (pipe(fds) != 0) {
+		std::perror("pipe");
+		return false;
+	}
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+	posix_spawn_file_actions_addclose(&actions, fds[0]);
+	posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+	const auto start = Clock::now();
+
+	pid_t pid;
+	const int error = posix_spawn(&pid, command[0], &actions, nullptr, command, environ);
+	posix_spawn_file_actions_destroy(&actions);
+	close(fds[1]);
+	if (error != 0) {
+		std::fprintf(stderr, "Could not spawn %s\n", command[0]);
+		close(fds[0]);
+		return false;
+	}
+
+	// The first read returns as soon as the child produced any output.
+	char buffer[4096];
+	bool first = true;
+	while (true) {
+		const auto count = read(fds[0], buffer, sizeof(buffer));
+		if (count <= 0) {
+			break;
+		}
+		if (first) {
+			sample.firstOutputUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+			first = false;
+		}
+	}
+	close(fds[0]);
+
+	int status;
+	waitpid(pid, &status, 0);
+	sample.exitUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+	if (first) {
+		sample.firstOutputUs = sample.exitUs;
+	}
+	return true;
+}
+
+void report(const char* label, std::vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+	double sum = 0.0;
+	for (double value : values) {
+		sum += value;
+	}
+	const auto percentile = [&](double p) { return values[std::size_t(p * double(values.size() - 1))]; };
+	std::printf("%-14s min %8.1f us  median %8.1f us  p90 %8.1f us  mean %8.1f us\n", label, values.front(),
+	            percentile(0.5), percentile(0.9), sum / double(values.size()));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3) {
+		std::printf("usage: %s <runs> <command> [args...]\n\n", argv[0]);
+		return 1;
+	}
+
+	const int runs = std::atoi(argv[1]);
+	if (runs <= 0) {
+		std::printf("Invalid number of runs: %s\n", argv[1]);
+		return 1;
+	}
+
+	// One run to warm up the page cache, not recorded.
+	Sample sample;
+	if (!runOnce(argv + 2, sample)) {
+		return 1;
+	}
+
+	std::vector<double> firstOutput;
+	std::vector<double> exit;
+	for (int i = 0; i < runs; i++) {
+		if (!runOnce(argv + 2, sample)) {
+			return 1;
+		}
+		firstOutput.push_back(sample.firstOutputUs);
+		exit.push_back(sample.exitUs);
+	}
+
+	std::printf("%d runs of %s\n", runs, argv[2]);
+	report("first output", std::move(firstOutput));
+	report("exit", std::move(exit));
+
+	return 0;
+}